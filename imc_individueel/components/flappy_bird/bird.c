@@ -5,16 +5,24 @@
 
 #include "include/bird.h"
 
-// Draws the bird given to the function on the matrix array given to the function
-void bird_draw(bird_t** bird, matrix_array_t** matrix_array)
+/*
+    Updates the position and velocity of the bird, the bird follows the same path whatever the length of [deltatime] is.
+    With a deltatime of 1 the velocity is updated first and the position moves by the new velocity, a step of any other
+    length moves the bird along the curve of constant acceleration through the positions of those steps
+*/
+void bird_update(bird_t** bird, fixed_t deltatime)
 {
-    // Set pixel on the matrix array cooresponding to the x and y position of the bird to (true : on : 1)
-    matrix_array_set_pixel(matrix_array, (int)(*bird)->xPosition, (int)(*bird)->yPosition, true);
+    fixed_t acceleration = (*bird)->yAcceleration;
+    int64_t distance = (int64_t)(*bird)->yVelocity * deltatime + (int64_t)acceleration * deltatime * (FIXED_POINT_ONE + deltatime) / (2 * FIXED_POINT_ONE);
+    fixed_add_product(&(*bird)->yPosition, &(*bird)->yRemainder, distance);    // Update y position with the y velocity and change in time since last update
+    (*bird)->yVelocity += fixed_mul(acceleration, deltatime);                  // Update y velocity with the y accelaration and change in time since last update
 }
 
-// Updates the position and velocity of the bird
-void bird_update(bird_t** bird, float deltatime)
+// Sets the sprite of the bird to the packed [rows] of [width] (at most 32) x [height] (at most BIRD_SPRITE_MAX_HEIGHT) pixels
+void bird_set_sprite(bird_t** bird, const uint32_t* rows, int width, int height)
 {
-    (*bird)->yVelocity += (*bird)->yAcceleration * deltatime;   // Update y velocity with the y accelaration and change in time since last update
-    (*bird)->yPosition += (*bird)->yVelocity;                   // Update y position with the y velocity
+    (*bird)->spriteWidth = (width < 32) ? width : 32;
+    (*bird)->spriteHeight = (height < BIRD_SPRITE_MAX_HEIGHT) ? height : BIRD_SPRITE_MAX_HEIGHT;
+    for(int i = 0; i < BIRD_SPRITE_MAX_HEIGHT; i++)
+        (*bird)->spriteRows[i] = (i < (*bird)->spriteHeight) ? rows[i] : 0;     // Rows below the sprite stay empty so they never collide
 }
\ No newline at end of file
@@ -5,25 +5,54 @@
 
 #include "flappy_bird.h"
 
-static bird_t* bird = NULL;
-static pipelane_t* pipelane1 = NULL;
-static pipelane_t* pipelane2 = NULL;
+static flappy_bird_sim_t sim;                          // State of the game, the rules are simulated by flappy_bird_sim
+static bool flap_requested = false;                     // Boolean value for indicating the button was pressed since the last step, only used atomically
+static flappy_bird_recorder_t recorder;                 // Recording of the game that is played, only used when a write function is set
+static flappy_bird_replay_write_t record_write = NULL;  // Function the next games are recorded with, NULL if they are not recorded
+static void* record_context = NULL;
+static flappy_bird_player_t player;                     // Playback of the replay that is played instead of the button
+static bool is_replaying = false;                       // Boolean value for indicating the game plays a replay
+static high_score_t high_scores;                        // High score table of the rounds played with the button, written to NVS by its own task
+static unsigned long round_start_step = 0;              // Step of the game the current round started at
+static bool is_round_waiting = false;                   // Boolean value for indicating the round waits for its first flap, the high score table may be written then
 static matrix_array_t* matrix_array = NULL;
 static gpio_button_t* gpio_button = NULL;
 static buzzer_t* buzzer = NULL;
 
 static bool is_playing = false;
 static bool is_ready = false;
-static bool first_flap = true;
-static TimerHandle_t timer_handle;
+static TaskHandle_t task_handle = NULL;
+static SemaphoreHandle_t stopped_semaphore = NULL;     // Semaphore the game task gives when it has stopped
+static volatile bool is_stopping = false;               // Boolean value for indicating the game task has to stop
+static flappy_bird_stats_t stats;                       // Timing of the game task
+static frame_pacer_t frame_pacer;
+static fixed_step_t fixed_step;
+static int pipes_layer = MATRIX_ARRAY_FRAMEBUFFER;      // Layer of the matrix array the pipelanes are drawn on
+static int bird_layer = MATRIX_ARRAY_FRAMEBUFFER;       // Layer of the matrix array the bird is drawn on, on top of the pipelanes
+static int drawn_pipes[PIPELANE_POOL_MAX_COUNT * 2];    // Pixel position and opening of every pipelane currently on the canvas, -1 if not drawn or outside the canvas
+static int drawn_bird[2] = { -1, -1 };                  // Pixel position of the bird currently on the bird layer
+
+static const uint32_t FLAPPY_BIRD_TASK_STACK_SIZE = 4096;
+static const unsigned int FLAPPY_BIRD_TASK_PERIOD = 10;    // Time in milliseconds between two runs of the game loop, rounded to whole ticks
+static const unsigned int FLAPPY_BIRD_TARGET_FPS = 50;     // Frame rate the matrix array is flushed at, independent of the simulation
+static const unsigned int FLAPPY_BIRD_STEP_RATE = 100;     // Simulation steps per second, the same on every tick rate and bus speed
+static const unsigned int FLAPPY_BIRD_TUNING_RATE = 100;   // Step rate the velocities and accelerations of the bird and pipelanes are tuned for
+static const unsigned int FLAPPY_BIRD_MAX_STEPS = 5;       // Maximum ammount of steps caught up in one update, the game slows down instead of freezing after a longer stall
+static const unsigned int FLAPPY_BIRD_CANVAS_WIDTH = 24;    // Width of the canvas the pipelanes are drawn on, wide enough for pipelanes that are not shown yet
+static const unsigned int FLAPPY_BIRD_CANVAS_HEIGHT = 16;
+static const char* FLAPPY_BIRD_HIGH_SCORE_NAME = "flappy_bird";    // Key the high score table is stored under in NVS
+static const UBaseType_t FLAPPY_BIRD_HIGH_SCORE_PRIORITY = 1;      // Priority of the task writing the high score table, below the game task
+static const BaseType_t FLAPPY_BIRD_HIGH_SCORE_CORE = 0;           // Core of the task writing the high score table, writing the flash pauses the game on the other core as well so writes are only allowed while the game is idle
 
 static sequence_segment_t* score_sequence = NULL;
 static sequence_segment_t* fail_sequence = NULL;
 
-void flappy_bird_setup();
 void flappy_bird_update();
-void flappy_bird_set_random_opening_position(pipelane_t** pipelane, int upper, int lower);
-void flappy_bird_timer_callback(TimerHandle_t xTimer);
+void flappy_bird_step();
+void flappy_bird_draw();
+void flappy_bird_draw_pipelane(unsigned int index);
+void flappy_bird_task(void* arg);
+bool flappy_bird_start_task(UBaseType_t priority, BaseType_t core_id);
 
 // Initializes the flappy bird game
 void flappy_bird_init()
@@ -31,18 +60,20 @@ void flappy_bird_init()
     // Check if the flappy bird game is ready to be played and if not initialize all essentials
     if(!is_ready)
     {
-        bird = (bird_t*)malloc(sizeof(bird_t));                             // Allocate memory for the bird
-        pipelane1 = (pipelane_t*)malloc(sizeof(pipelane_t));                // Allocate memory for the first pipelane
-        pipelane2 = (pipelane_t*)malloc(sizeof(pipelane_t));                // Allocate memory for the second pipelane
-
         matrix_array = (matrix_array_t*)malloc(sizeof(matrix_array_t));     // Allocate memory for the matrix array
         matrix_array->is_initialized = false;
         matrix_array_init(&matrix_array, VERTICAL);                         // Initialize the matrix array in vertical orientation
-        matrix_array_add_matrix_display(&matrix_array, 0x70);               // Add first matrix diaply to the matrix array
-        matrix_array_add_matrix_display(&matrix_array, 0x71);               // Add second matrix diaply to the matrix array
+        // Add both matrix displays at once so they are set up together
+        matrix_array_display_address_t display_addresses[2] = { { I2C_NUM_0, 0x70 }, { I2C_NUM_0, 0x71 } };
+        matrix_array_add_matrix_displays(&matrix_array, display_addresses, 2);
+        pipes_layer = matrix_array_add_layer(&matrix_array, LAYER_BLEND_OR);    // Add layer for the pipelanes
+        bird_layer = matrix_array_add_layer(&matrix_array, LAYER_BLEND_OR);     // Add layer for the bird on top of the pipelanes
+        // Attach a canvas shown on the pipes layer, the world scrolls by shifting the canvas instead of redrawing the pipelanes
+        matrix_array_attach_canvas(&matrix_array, FLAPPY_BIRD_CANVAS_WIDTH, FLAPPY_BIRD_CANVAS_HEIGHT, pipes_layer);
 
         gpio_button = (gpio_button_t*)malloc(sizeof(gpio_button_t));        // Allocate memory for the gpio button
         gpio_button->gpio_pin = 19;
+        gpio_button->is_listening = false;
         gpio_button->onButtonPressed = &flappy_bird_flap;
         
         buzzer = (buzzer_t*)malloc(sizeof(buzzer_t));                       // Allocate memory for the buzzer
@@ -68,7 +99,11 @@ void flappy_bird_init()
         fail_sequence[3].frequency = 100;
         fail_sequence[3].duration = 500;
 
-        srand(time(0));     // Set random seed
+        stopped_semaphore = xSemaphoreCreateBinary();  // Create semaphore for waiting until the game task has stopped
+
+        // Load the high score table, the game is played without one when it can not be started
+        high_scores.is_initialized = false;
+        high_score_init(&high_scores, FLAPPY_BIRD_HIGH_SCORE_NAME, FLAPPY_BIRD_HIGH_SCORE_PRIORITY, FLAPPY_BIRD_HIGH_SCORE_CORE);
         is_ready = true;    // Set flappy bird game state to ready
     }
 }
@@ -79,10 +114,6 @@ void flappy_bird_deinit()
     // Check if the flappy bird game is ready to be played and is not playing
     if(is_ready && !is_playing)
     {
-        free(bird);                             // Free memory of the bird
-        free(pipelane1);                        // Free memory of the first pipelane
-        free(pipelane2);                        // Free memory of the desocnd pipelane
-
         matrix_array_deinit(&matrix_array);     // Uninitialize matrix array
         buzzer_deinit(&buzzer);                 // Uninitialize buzzer
         free(matrix_array);                     // Free memory of matrix array
@@ -91,134 +122,297 @@ void flappy_bird_deinit()
 
         free(score_sequence);                   // Free memory of the score_sequence
         free(fail_sequence);                    // Free memory of the fail_sequence
+        vSemaphoreDelete(stopped_semaphore);    // Delete the semaphore of the game task
+        high_score_deinit(&high_scores);        // Write the high score table if it changed and stop its task
         is_ready = false;                       // Set flappy bird game state to not ready
     }
 }
 
-// Start the flappy bird game and the task that updates the game
-void flappy_bird_start()
+// Start the flappy bird game and the task that updates the game with priority [priority] pinned to core [core_id] (or tskNO_AFFINITY)
+void flappy_bird_start(UBaseType_t priority, BaseType_t core_id)
 {
     // Check if the flappy bird game is ready to be played and is not playing
     if(is_ready && !is_playing)
     {
-        flappy_bird_setup();                            // Setup flappy bird game
-        is_playing = true;
-        // Create timer for updating the game
-        timer_handle = xTimerCreate("flappy_bird_timer", pdMS_TO_TICKS(10), pdTRUE, NULL, &flappy_bird_timer_callback);
-        xTimerStart(timer_handle, 10);                  // Start the timer for updating the game
-        gpio_button_start_listener(&gpio_button);       // Start listening for button input
+        // Setup the flappy bird game with the default rules at the step rate of the game
+        flappy_bird_sim_config_t config;
+        flappy_bird_sim_default_config(&config);
+        config.deltatime = FIXED_FROM_INT(FLAPPY_BIRD_TUNING_RATE) / FLAPPY_BIRD_STEP_RATE;
+        unsigned int seed = esp_random();      // The hardware random number generator seeds every game differently, the clock starts at the same time every boot
+        if(!flappy_bird_sim_init(&sim, &config, seed))
+            return;
+        is_replaying = false;
+        round_start_step = 0;
+        high_score_begin_session(&high_scores);         // Every game that is started is a new session of the high score table
+        high_score_allow_writes(&high_scores, false);   // Writing the flash would pause the game, the table is written while the bird waits for the first flap of a round or the game is stopped
+        is_round_waiting = false;
+
+        // Record the game from its first step when recording is turned on
+        recorder.is_initialized = false;
+        if(record_write != NULL)
+            flappy_bird_recorder_init(&recorder, &config, seed, record_write, record_context);
+
+        if(flappy_bird_start_task(priority, core_id))
+            gpio_button_start_listener(&gpio_button);   // Start listening for button input
+        else
+        {
+            flappy_bird_recorder_deinit(&recorder);
+            flappy_bird_sim_deinit(&sim);
+            high_score_allow_writes(&high_scores, true);
+        }
     }
 }
 
+// Starts playing the replay of [size] bytes at [data] instead of the button with the task that updates the game, the replay has to stay in memory until the game is stopped
+bool flappy_bird_start_replay(const uint8_t* data, size_t size, UBaseType_t priority, BaseType_t core_id)
+{
+    // Check if the flappy bird game is ready to be played and is not playing
+    if(!is_ready || is_playing || !flappy_bird_player_init(&player, data, size))
+        return false;
+
+    // The game is set up with the rules and seed it was recorded with, the flaps come from the replay at the steps they were recorded at
+    if(!flappy_bird_player_setup(&player, &sim))
+        return false;
+    is_replaying = true;
+    round_start_step = 0;
+    recorder.is_initialized = false;
+    if(!flappy_bird_start_task(priority, core_id))
+    {
+        flappy_bird_sim_deinit(&sim);
+        return false;
+    }
+    return true;
+}
+
+// Sets the function the games started after this are recorded with, the game task calls it with the bytes of the replay, NULL stops recording
+void flappy_bird_set_recording(flappy_bird_replay_write_t write, void* context)
+{
+    record_write = write;
+    record_context = context;
+}
+
+// Starts the task that updates the game that was set up with priority [priority] pinned to core [core_id] (or tskNO_AFFINITY), returns false if the task could not be created
+bool flappy_bird_start_task(UBaseType_t priority, BaseType_t core_id)
+{
+    __atomic_store_n(&flap_requested, false, __ATOMIC_RELEASE);
+    frame_pacer.is_initialized = false;
+    frame_pacer_init(&frame_pacer, FLAPPY_BIRD_TARGET_FPS);    // Initialize the frame pacer for flushing the matrix array
+    fixed_step.is_initialized = false;
+    fixed_step_init(&fixed_step, FLAPPY_BIRD_STEP_RATE, FLAPPY_BIRD_MAX_STEPS);  // Initialize the accumulator handing out the simulation steps
+    memset(drawn_pipes, -1, sizeof(drawn_pipes));  // Nothing is drawn on the layers of a new matrix array yet
+    memset(drawn_bird, -1, sizeof(drawn_bird));
+    memset(&stats, 0, sizeof(stats));
+    is_stopping = false;
+    is_playing = true;
+    // Create the task for updating the game, the timer service task is not blocked by a slow frame
+    if(xTaskCreatePinnedToCore(&flappy_bird_task, "flappy_bird", FLAPPY_BIRD_TASK_STACK_SIZE, NULL, priority, &task_handle, core_id) != pdPASS)
+    {
+        task_handle = NULL;
+        is_playing = false;
+        return false;
+    }
+    return true;
+}
+
 // Stops the flappy bird game and the task that updates the game
 void flappy_bird_stop()
 {
     // Check if the flappy bird game is playing
     if(is_playing)
     {
+        // The game task stops after the frame it is running
+        is_stopping = true;
+        xSemaphoreTake(stopped_semaphore, portMAX_DELAY);
+        task_handle = NULL;
         is_playing = false;
-        xTimerStop(timer_handle, 10);                   // Stop the timer for updating the game
-        xTimerDelete(timer_handle, 10);                 // Delete the timer for updating the game
         gpio_button_stop_stop_listener(&gpio_button);   // Stop listening for button input
+        flappy_bird_recorder_deinit(&recorder);         // Write the end of the recording, the steps after the last flap are part of it
+        flappy_bird_sim_deinit(&sim);                   // Release the obstacle layer of the game
+        high_score_allow_writes(&high_scores, true);    // The game is idle, the high score table can be written
     }
 }
 
 // Propels the bird upwards by setting a certain velocity in the opposite direction as gravity 
 void flappy_bird_flap()
 {
-    // Check if the flappy bird game is playing
+    // Check if the flappy bird game is playing, the flap is done by the next step of the game task
+    if(is_playing && !is_replaying)
+        __atomic_store_n(&flap_requested, true, __ATOMIC_RELEASE);
+}
+
+// Updates the flappy bird game by running the simulation steps that are due and drawing the bird and pipelanes on the matrix array when a frame is due
+void flappy_bird_update()
+{
     if(is_playing)
-        bird->yVelocity = -0.8f;
+    {
+        // Run the steps for the time that passed since the last update, however late or irregular the timer fired
+        unsigned int steps = fixed_step_advance(&fixed_step);
+        for(unsigned int i = 0; i < steps; i++)
+            flappy_bird_step();
 
-    // Check if the user has pressed the button for the fisrt time to start the round
-    if(first_flap)
-        first_flap = false;
+        // Check if a frame is due, otherwise the steps are shown with the next frame so a slow bus does not slow down the game
+        if(frame_pacer_begin_frame(&frame_pacer))
+        {
+            flappy_bird_draw();                         // Draw the pipelanes and bird on their layers
+            matrix_array_update(&matrix_array);         // Compose the layers and update the matrix array with the values in the matrix displays
+            frame_pacer_end_frame(&frame_pacer, matrix_array->last_flush_time);     // Record how long the flush took
+        }
+    }
 }
 
-// Sets up the flappy bird game and set the propperties of the bird and pipelanes
-void flappy_bird_setup()
-{    
-    bird->xPosition = 2.0f;
-    bird->yPosition = 7.0f;
-    bird->yVelocity = -1.0f;
-    bird->yAcceleration = 0.1f;
+// Advances the game by one simulation step and plays the sound of a crash or score
+void flappy_bird_step()
+{
+    // Take the flap and clear it in one operation, a press between reading and clearing would be lost otherwise
+    bool flap = __atomic_exchange_n(&flap_requested, false, __ATOMIC_ACQ_REL);
 
-    pipelane1->xPosition = 10.0f;
-    pipelane1->openingYPosition = 8.0f;
-    pipelane1->openingSize = 4.0f;
+    // A replay gives the flap of every step, the world stands still when the replay has ended
+    if(is_replaying && !flappy_bird_player_next(&player, &flap))
+        return;
 
-    pipelane2->xPosition = 16.0f;
-    pipelane2->openingYPosition = 8.0f;
-    pipelane2->openingSize = 4.0f;
+    flappy_bird_recorder_step(&recorder, flap);
+    unsigned int events = flappy_bird_sim_step(&sim, flap);
 
-    flappy_bird_set_random_opening_position(&pipelane1, 12, 3);
-    flappy_bird_set_random_opening_position(&pipelane2, 12, 3);
+    // Check if the bird collided with either a pipelane, the ceiling or the ground, the round was reset by the simulation
+    if(events & FLAPPY_BIRD_SIM_EVENT_CRASH)
+    {
+        // Add the round to the high score table, this only changes the table in memory and the flash is written later by its own task
+        if(!is_replaying)
+            high_score_submit(&high_scores, sim.last_score, (uint32_t)(sim.step_count - round_start_step));
+        round_start_step = sim.step_count;
+
+        buzzer->sequence = fail_sequence;   // Set current sequence of the buzzer to the fail sequence sound
+        buzzer->segments_count = 4;         // Set length of sequence to the length of the fail sequence sound
+        buzzer_play_sequence(&buzzer);      // Play fail sequence
+    }
+    else if(events & FLAPPY_BIRD_SIM_EVENT_SCORE)
+    {
+        buzzer->sequence = score_sequence;  // Set current sequence of the buzzer to the score sequence sound
+        buzzer->segments_count = 3;         // Set length of sequence to the length of the score sequence sound
+        buzzer_play_sequence(&buzzer);      // Play score sequence
+    }
 
-    first_flap = true;      // Reset first_flap to true to wait for updating when button is not yet pressed
+    // The high score table is only written while the bird waits for the first flap of a round, a write during a round would pause the game
+    if(!is_replaying && is_round_waiting == sim.is_started)
+    {
+        is_round_waiting = !sim.is_started;
+        high_score_allow_writes(&high_scores, is_round_waiting);
+    }
 }
 
-// Updates the flappy bird game by updateing the bird and pipelanes and drawing them on the matrix array
-void flappy_bird_update()
+// Draws the pipelanes on the canvas and the bird on its layer, only what has moved is drawn again
+void flappy_bird_draw()
 {
-    if(is_playing)
+    const pipelane_pool_t* pipelanes = &sim.pipelanes;
+    int pipes[PIPELANE_POOL_MAX_COUNT * 2];
+    bool is_canvas_empty = true;
+    for(unsigned int i = 0; i < pipelanes->count; i++)
     {
-        matrix_array_clear(&matrix_array);          // Clear the matrix array
-
-        // Check if game can update if the button was pressed one time
-        if(!first_flap)
-        {
-            pipelane_update(&pipelane1, -0.2f, pdMS_TO_TICKS(10));      // Update the first pipelane
-            pipelane_update(&pipelane2, -0.2f, pdMS_TO_TICKS(10));      // Update the second pipelane
-            bird_update(&bird, pdMS_TO_TICKS(10));
-
-            // Check if the pipelanes are off the left side of the matrix array and if so reset there position zo the pipelanes look infinite
-            if(pipelane1->xPosition < 0)
-            {
-                pipelane1->xPosition = pipelane2->xPosition + 6.0f;
-                flappy_bird_set_random_opening_position(&pipelane1, 12, 3);
-            }
-            else if(pipelane2->xPosition < 0)
-            {
-                pipelane2->xPosition = pipelane1->xPosition + 6.0f;
-                flappy_bird_set_random_opening_position(&pipelane2, 12, 3);
-            }
-        }
-
-        pipelane_draw(&pipelane1, &matrix_array);   // Draw the first pipelane on the matrix array
-        pipelane_draw(&pipelane2, &matrix_array);   // Draw the second pipelane on the matrix array
-        bird_draw(&bird, &matrix_array);            // Draw the bird on the matrix arraya
+        // A pipelane outside the canvas can not be drawn, it counts as not drawn so it is drawn once it moved onto the canvas
+        int x = fixed_to_int(pipelanes->xPositions[i]);
+        bool is_on_canvas = x >= 0 && x < (int)FLAPPY_BIRD_CANVAS_WIDTH;
+        pipes[i * 2] = is_on_canvas ? x : -1;
+        pipes[i * 2 + 1] = is_on_canvas ? pipelanes->openingTops[i] : -1;
+        is_canvas_empty &= (drawn_pipes[i * 2 + 1] == -1);
+    }
 
-        matrix_array_update(&matrix_array);         // Update the matrix array with the values in the matrix displays
+    if(memcmp(pipes, drawn_pipes, pipelanes->count * 2 * sizeof(int)) != 0)
+    {
+        matrix_array_select_layer(&matrix_array, MATRIX_ARRAY_CANVAS);
+        if(is_canvas_empty)
+            matrix_array_clear(&matrix_array);      // Clear what is left on the canvas of a previous game, all the pipelanes are drawn the first time together
 
-        // Checki if the bird is colliding with either a pipelane, the ceiling or the ground
-        if(pipelane_check_collsion(&pipelane1, bird->xPosition, bird->yPosition) ||
-                pipelane_check_collsion(&pipelane2, bird->xPosition, bird->yPosition) || bird->yPosition < 0 || bird->yPosition > 17)
+        // Scroll the canvas by the distance a drawn pipelane with the same opening moved to the left, the pipelanes move together and a recycled pipelane moves to the right
+        int scroll = 0;
+        for(unsigned int i = 0; i < pipelanes->count && scroll == 0; i++)
         {
-            buzzer->sequence = fail_sequence;   // Set current sequence of the buzzer to the fail sequence sound
-            buzzer->segments_count = 4;         // Set length of sequence to the length of the fail sequence sound
-            flappy_bird_setup();                // Reset the flappy bird game after colliding with either a pipelane, the ceiling or the ground   
-            buzzer_play_sequence(&buzzer);      // Play fail sequence
+            if(drawn_pipes[i * 2 + 1] != -1 && drawn_pipes[i * 2 + 1] == pipes[i * 2 + 1] && pipes[i * 2] < drawn_pipes[i * 2])
+                scroll = pipes[i * 2] - drawn_pipes[i * 2];
         }
+        matrix_array_scroll_canvas(&matrix_array, scroll, 0);
 
-        if(pipelane_check_opening(&pipelane1, bird->xPosition, bird->yPosition) ||
-                pipelane_check_opening(&pipelane2, bird->xPosition, bird->yPosition))
+        // Only the pipelanes that did not end up where the scroll moved them (new or recycled pipelanes) are drawn again
+        for(unsigned int i = 0; i < pipelanes->count; i++)
         {
-            buzzer->sequence = score_sequence;  // Set current sequence of the buzzer to the score sequence sound
-            buzzer->segments_count = 3;         // Set length of sequence to the length of the score sequence sound
-            buzzer_play_sequence(&buzzer);      // Play score sequence
+            if(drawn_pipes[i * 2 + 1] != -1 && drawn_pipes[i * 2] + scroll == pipes[i * 2] && drawn_pipes[i * 2 + 1] == pipes[i * 2 + 1])
+                continue;
+
+            if(drawn_pipes[i * 2 + 1] != -1)
+                matrix_array_draw_vline(&matrix_array, drawn_pipes[i * 2] + scroll, 0, FLAPPY_BIRD_CANVAS_HEIGHT, false);   // Erase the old pipelane
+            if(pipes[i * 2 + 1] != -1)
+                flappy_bird_draw_pipelane(i);   // Draw the pipelane on the canvas
         }
+        memcpy(drawn_pipes, pipes, pipelanes->count * 2 * sizeof(int));
     }
+
+    int bird_pixel[2] = { fixed_to_int(sim.bird.xPosition), fixed_to_int(sim.bird.yPosition) };
+    if(memcmp(bird_pixel, drawn_bird, sizeof(bird_pixel)) != 0)
+    {
+        matrix_array_select_layer(&matrix_array, bird_layer);
+        matrix_array_clear(&matrix_array);          // Clear the bird layer
+        for(int i = 0; i < sim.bird.spriteHeight; i++)
+            matrix_array_set_row_bits(&matrix_array, bird_pixel[0], bird_pixel[1] + i, sim.bird.spriteWidth, sim.bird.spriteRows[i]);   // Draw the sprite of the bird on the matrix array
+        memcpy(drawn_bird, bird_pixel, sizeof(bird_pixel));
+    }
+}
+
+// Draws pipelane [index] of the game on the selected layer with the pipelane pool and marks its column as drawn
+void flappy_bird_draw_pipelane(unsigned int index)
+{
+    pipelane_pool_draw_pipelane(&sim.pipelanes, index, matrix_array_get_selected_bitmap(&matrix_array));
+    matrix_array_mark_region_drawn(&matrix_array, fixed_to_int(sim.pipelanes.xPositions[index]), 0, 1, FLAPPY_BIRD_CANVAS_HEIGHT);
+}
+
+// Returns the timing of the game task since the game was started
+flappy_bird_stats_t flappy_bird_get_stats()
+{
+    return stats;
 }
 
-// Set the opening of the pipeline given to the function to a random y position between [lower] and [upper]
-void flappy_bird_set_random_opening_position(pipelane_t** pipelane, int upper, int lower)
+// Stores a copy of the high score table and the statistics of the rounds played in [record]
+void flappy_bird_get_high_scores(high_score_record_t* record)
 {
-    int num = (rand() % (upper - lower + 1)) + lower;   // Generate random integer
-    (*pipelane)->openingYPosition = (float)num;         // Set opening y position
+    high_score_get_record(&high_scores, record);
 }
 
-// Callback function for the flappy bird game calling the update method for the flappy bird game
-void flappy_bird_timer_callback(TimerHandle_t xTimer)
+// Function for the game task that runs the game loop every period until the game is stopped
+void flappy_bird_task(void* arg)
 {
-    flappy_bird_update();   // Update the flappy bird game
+    TickType_t period = (pdMS_TO_TICKS(FLAPPY_BIRD_TASK_PERIOD) > 0) ? pdMS_TO_TICKS(FLAPPY_BIRD_TASK_PERIOD) : 1;
+    int64_t period_time = (int64_t)period * 1000000 / configTICK_RATE_HZ;     // Period in microseconds
+    TickType_t last_wake_time = xTaskGetTickCount();
+    int64_t last_start_time = 0;
+
+    while(!is_stopping)
+    {
+        // Measure how far the time between the start of this loop and the last loop is off from the period
+        int64_t start_time = esp_timer_get_time();
+        if(stats.frame_count > 0)
+        {
+            stats.last_jitter = start_time - last_start_time - period_time;
+            if(stats.last_jitter < 0)
+                stats.last_jitter = -stats.last_jitter;
+            if(stats.last_jitter > stats.max_jitter)
+                stats.max_jitter = stats.last_jitter;
+        }
+        last_start_time = start_time;
+
+        flappy_bird_update();   // Update the flappy bird game
+
+        stats.last_loop_time = esp_timer_get_time() - start_time;
+        if(stats.last_loop_time > stats.max_loop_time)
+            stats.max_loop_time = stats.last_loop_time;
+        stats.frame_count++;
+
+        // After an overrun the next period starts now instead of running the missed loops back to back, the fixed timestep catches up on the simulation
+        if(stats.last_loop_time > period_time)
+        {
+            stats.overrun_count++;
+            last_wake_time = xTaskGetTickCount();
+        }
+        vTaskDelayUntil(&last_wake_time, period);
+    }
+
+    xSemaphoreGive(stopped_semaphore);  // Report the game task has stopped
+    vTaskDelete(NULL);  // Delete the task, it is not needed anymore
 }
\ No newline at end of file
@@ -0,0 +1,213 @@
+/*
+    Author: Kenley Strik
+    Addition: This whole file was written by Kenley Strik
+*/
+
+#include "include/flappy_bird_replay.h"
+
+#include <string.h>
+
+// Stores [value] as a varint at [buffer], returns the ammount of bytes used (at most 5)
+static size_t flappy_bird_replay_put_varint(uint8_t* buffer, uint32_t value)
+{
+    size_t length = 0;
+    while(value >= 0x80)
+    {
+        buffer[length++] = (uint8_t)(value | 0x80);
+        value >>= 7;
+    }
+    buffer[length++] = (uint8_t)value;
+    return length;
+}
+
+// Stores the signed [value] as a zigzag encoded varint at [buffer], returns the ammount of bytes used (at most 5)
+static size_t flappy_bird_replay_put_signed(uint8_t* buffer, int32_t value)
+{
+    return flappy_bird_replay_put_varint(buffer, ((uint32_t)value << 1) ^ (uint32_t)(value >> 31));
+}
+
+// Writes [value] as a varint with the write function of the recorder, after a failed write nothing is written anymore
+static void flappy_bird_recorder_write_varint(flappy_bird_recorder_t* recorder, uint32_t value)
+{
+    uint8_t buffer[5];
+    size_t length = flappy_bird_replay_put_varint(buffer, value);
+    if(!recorder->has_failed && !recorder->write(recorder->context, buffer, length))
+        recorder->has_failed = true;
+}
+
+// Reads a varint of the replay into [value], returns false if the replay ends before the varint does
+static bool flappy_bird_player_read_varint(flappy_bird_player_t* player, uint32_t* value)
+{
+    uint32_t result = 0;
+    for(int shift = 0; shift < 35 && player->position < player->size; shift += 7)
+    {
+        uint8_t byte = player->data[player->position++];
+        result |= (uint32_t)(byte & 0x7F) << shift;
+        if((byte & 0x80) == 0)
+        {
+            *value = result;
+            return true;
+        }
+    }
+    return false;
+}
+
+// Reads a zigzag encoded varint of the replay into [value], returns false if the replay ends before the varint does
+static bool flappy_bird_player_read_signed(flappy_bird_player_t* player, int32_t* value)
+{
+    uint32_t encoded;
+    if(!flappy_bird_player_read_varint(player, &encoded))
+        return false;
+    *value = (int32_t)(encoded >> 1) ^ -(int32_t)(encoded & 1);
+    return true;
+}
+
+// Reads the step of the flap after the one at [next_flap_step], or the end of the replay
+static void flappy_bird_player_read_flap(flappy_bird_player_t* player)
+{
+    unsigned long last_flap_step = player->next_flap_step;
+    uint32_t delta;
+    player->next_flap_step = 0;
+
+    // A replay that was cut off ends at its last flap
+    if(!flappy_bird_player_read_varint(player, &delta))
+    {
+        player->end_step = last_flap_step;
+        player->has_end = true;
+    }
+    else if(delta == 0)
+    {
+        uint32_t remaining = 0;
+        flappy_bird_player_read_varint(player, &remaining);
+        player->end_step = last_flap_step + remaining;
+        player->has_end = true;
+    }
+    else
+        player->next_flap_step = last_flap_step + delta;
+}
+
+// Initializes the recorder given to the function and writes the header for a game initialized with [config] and [seed], returns false if the header could not be written
+bool flappy_bird_recorder_init(flappy_bird_recorder_t* recorder, const flappy_bird_sim_config_t* config, unsigned int seed, flappy_bird_replay_write_t write, void* context)
+{
+    // Check if recorder is initialized and if not initialize it
+    if(!recorder->is_initialized)
+    {
+        recorder->write = write;
+        recorder->context = context;
+        recorder->step_count = 0;
+        recorder->last_flap_step = 0;
+        recorder->flap_count = 0;
+
+        // The header holds everything flappy_bird_sim_init was called with, so the game can be set up again exactly
+        uint8_t header[FLAPPY_BIRD_REPLAY_MAX_HEADER_SIZE];
+        size_t length = 0;
+        memcpy(header, FLAPPY_BIRD_REPLAY_MAGIC, 4);
+        length += 4;
+        header[length++] = FLAPPY_BIRD_REPLAY_VERSION;
+        length += flappy_bird_replay_put_varint(&header[length], seed);
+        length += flappy_bird_replay_put_varint(&header[length], config->pipelane_count);
+        length += flappy_bird_replay_put_signed(&header[length], config->flap_velocity);
+        length += flappy_bird_replay_put_signed(&header[length], config->gravity);
+        length += flappy_bird_replay_put_signed(&header[length], config->pipelane_velocity);
+        length += flappy_bird_replay_put_signed(&header[length], config->pipelane_spacing);
+        length += flappy_bird_replay_put_signed(&header[length], config->opening_size);
+        length += flappy_bird_replay_put_signed(&header[length], config->opening_min);
+        length += flappy_bird_replay_put_signed(&header[length], config->opening_max);
+        length += flappy_bird_replay_put_signed(&header[length], config->floor);
+        length += flappy_bird_replay_put_signed(&header[length], config->deltatime);
+        recorder->has_failed = !write(context, header, length);
+        if(recorder->has_failed)
+            return false;
+
+        recorder->is_initialized = true;
+    }
+    return true;
+}
+
+// Writes the end of the replay and deinitializes the recorder given to the function
+void flappy_bird_recorder_deinit(flappy_bird_recorder_t* recorder)
+{
+    // Check if recorder is initialized
+    if(recorder->is_initialized)
+    {
+        flappy_bird_recorder_write_varint(recorder, 0);
+        flappy_bird_recorder_write_varint(recorder, (uint32_t)(recorder->step_count - recorder->last_flap_step));
+        recorder->is_initialized = false;
+    }
+}
+
+// Records the next step of the game, [flap] is the input the step was played with
+void flappy_bird_recorder_step(flappy_bird_recorder_t* recorder, bool flap)
+{
+    // Check if recorder is initialized, only the steps with a flap are written
+    if(recorder->is_initialized)
+    {
+        recorder->step_count++;
+        if(flap)
+        {
+            flappy_bird_recorder_write_varint(recorder, (uint32_t)(recorder->step_count - recorder->last_flap_step));
+            recorder->last_flap_step = recorder->step_count;
+            recorder->flap_count++;
+        }
+    }
+}
+
+// Initializes the player given to the function with the replay of [size] bytes at [data], which has to stay in memory, returns false if it is not a replay
+bool flappy_bird_player_init(flappy_bird_player_t* player, const uint8_t* data, size_t size)
+{
+    player->is_initialized = false;
+    if(size < 5 || memcmp(data, FLAPPY_BIRD_REPLAY_MAGIC, 4) != 0 || data[4] != FLAPPY_BIRD_REPLAY_VERSION)
+        return false;
+
+    player->data = data;
+    player->size = size;
+    player->position = 5;
+
+    uint32_t seed, pipelane_count;
+    int32_t values[9];
+    bool is_complete = flappy_bird_player_read_varint(player, &seed) && flappy_bird_player_read_varint(player, &pipelane_count);
+    for(int i = 0; i < 9 && is_complete; i++)
+        is_complete = flappy_bird_player_read_signed(player, &values[i]);
+    if(!is_complete)
+        return false;
+
+    player->seed = seed;
+    player->config.pipelane_count = pipelane_count;
+    player->config.flap_velocity = values[0];
+    player->config.gravity = values[1];
+    player->config.pipelane_velocity = values[2];
+    player->config.pipelane_spacing = values[3];
+    player->config.opening_size = values[4];
+    player->config.opening_min = values[5];
+    player->config.opening_max = values[6];
+    player->config.floor = values[7];
+    player->config.deltatime = values[8];
+
+    player->step_count = 0;
+    player->next_flap_step = 0;
+    player->end_step = 0;
+    player->has_end = false;
+    flappy_bird_player_read_flap(player);
+    player->is_initialized = true;
+    return true;
+}
+
+// Initializes [sim] with the rules and seed of the replay, the game is then played back with flappy_bird_player_next, returns false if there was not enough memory
+bool flappy_bird_player_setup(flappy_bird_player_t* player, flappy_bird_sim_t* sim)
+{
+    return flappy_bird_sim_init(sim, &player->config, player->seed);
+}
+
+// Stores the input of the next step in [flap], returns false if the replay has no steps left
+bool flappy_bird_player_next(flappy_bird_player_t* player, bool* flap)
+{
+    // Check if player is initialized and has steps left
+    if(!player->is_initialized || (player->has_end && player->step_count >= player->end_step))
+        return false;
+
+    player->step_count++;
+    *flap = player->step_count == player->next_flap_step;
+    if(*flap)
+        flappy_bird_player_read_flap(player);
+    return true;
+}
\ No newline at end of file
@@ -0,0 +1,158 @@
+/*
+    Author: Kenley Strik
+    Addition: This whole file was written by Kenley Strik
+*/
+
+#include "include/flappy_bird_sim.h"
+
+// Places the opening of pipelane [index] at a random y position between the lowest and highest position of the config
+static void flappy_bird_sim_place_opening(flappy_bird_sim_t* sim, unsigned int index)
+{
+    int range = sim->config.opening_max - sim->config.opening_min + 1;
+    int num = (int)pcg_random_below(&sim->random, (range > 0) ? (uint32_t)range : 1) + sim->config.opening_min;   // The random generator of the game is its own, so games do not share one
+    pipelane_pool_set_opening(&sim->pipelanes, index, FIXED_FROM_INT(num));
+}
+
+// Draws the pipelanes on the obstacle layer again if one of them reached another column or [is_placed] because openings were placed
+static void flappy_bird_sim_draw_obstacles(flappy_bird_sim_t* sim, bool is_placed)
+{
+    // The pipelanes move less than a pixel per step, so most steps the layer stays the same
+    bool has_moved = is_placed;
+    for(unsigned int i = 0; i < sim->pipelanes.count; i++)
+    {
+        int column = fixed_to_int(sim->pipelanes.xPositions[i]);
+        has_moved |= column != sim->drawn_columns[i];
+        sim->drawn_columns[i] = column;
+    }
+
+    if(has_moved)
+    {
+        matrix_bitmap_clear(&sim->obstacles);
+        pipelane_pool_draw(&sim->pipelanes, &sim->obstacles);
+    }
+}
+
+// Stores the rules of the game on the matrix array of two vertical displays in [config]
+void flappy_bird_sim_default_config(flappy_bird_sim_config_t* config)
+{
+    config->flap_velocity = FIXED_FROM_FLOAT(-0.8f);
+    config->gravity = FIXED_FROM_FLOAT(0.1f);
+    config->pipelane_count = 2;
+    config->pipelane_velocity = FIXED_FROM_FLOAT(-0.2f);
+    config->pipelane_spacing = FIXED_FROM_INT(6);
+    config->opening_size = FIXED_FROM_INT(4);
+    config->opening_min = 3;
+    config->opening_max = 12;
+    config->floor = FIXED_FROM_INT(17);
+    config->deltatime = FIXED_POINT_ONE;
+}
+
+// Initializes the game given to the function with the rules of [config] and the random generator at [seed], and sets up the first round, returns false if there was not enough memory
+bool flappy_bird_sim_init(flappy_bird_sim_t* sim, const flappy_bird_sim_config_t* config, unsigned int seed)
+{
+    // The obstacle layer reaches below the floor by the height of the largest sprite, so a bird just above the floor still collides with its lowest row
+    int floor_row = fixed_to_int(config->floor);
+    if(!matrix_bitmap_init(&sim->obstacles, FLAPPY_BIRD_SIM_WIDTH, (unsigned int)((floor_row > 0) ? floor_row : 0) + BIRD_SPRITE_MAX_HEIGHT))
+        return false;
+
+    // The bird is a single pixel until another sprite is set
+    bird_t* bird = &sim->bird;
+    uint32_t sprite = 0x1;
+    bird_set_sprite(&bird, &sprite, 1, 1);
+
+    sim->config = *config;
+    sim->seed = seed;
+    pcg_random_seed(&sim->random, seed, FLAPPY_BIRD_SIM_RANDOM_STREAM);
+    sim->step_count = 0;
+    sim->last_score = 0;
+    sim->crash_count = 0;
+    flappy_bird_sim_reset(sim);
+    return true;
+}
+
+// Releases the memory of the game
+void flappy_bird_sim_deinit(flappy_bird_sim_t* sim)
+{
+    matrix_bitmap_deinit(&sim->obstacles);
+}
+
+// Sets up a new round, the bird and pipelanes go back to their start positions and the world waits for the first flap
+void flappy_bird_sim_reset(flappy_bird_sim_t* sim)
+{
+    sim->bird.xPosition = FIXED_FROM_INT(2);
+    sim->bird.yPosition = FIXED_FROM_INT(7);
+    sim->bird.yVelocity = FIXED_FROM_INT(-1);
+    sim->bird.yRemainder = 0;
+    sim->bird.yAcceleration = sim->config.gravity;
+
+    // The first pipelane starts just outside the matrix array, the others follow at the spacing
+    pipelane_pool_init(&sim->pipelanes, sim->config.pipelane_count, FIXED_FROM_INT(10), sim->config.pipelane_spacing, sim->config.opening_size);
+    for(unsigned int i = 0; i < sim->pipelanes.count; i++)
+        flappy_bird_sim_place_opening(sim, i);
+    flappy_bird_sim_draw_obstacles(sim, true);
+
+    sim->score = 0;
+    sim->is_started = false;    // Wait for the first flap before the world moves
+}
+
+// Advances the game by one step, [flap] propels the bird upwards first, returns the FLAPPY_BIRD_SIM_EVENT flags of what happened
+unsigned int flappy_bird_sim_step(flappy_bird_sim_t* sim, bool flap)
+{
+    bird_t* bird = &sim->bird;
+    sim->step_count++;
+
+    if(flap)
+    {
+        bird->yVelocity = sim->config.flap_velocity;
+        sim->is_started = true;
+    }
+
+    // Check if the round has started, until the first flap the bird and pipelanes stand still
+    if(sim->is_started)
+    {
+        pipelane_pool_update(&sim->pipelanes, sim->config.pipelane_velocity, sim->config.deltatime);
+        bird_update(&bird, sim->config.deltatime);
+
+        // Check if a pipelane is off the left side of the matrix array and if so place it behind the last pipelane so the pipelanes look infinite
+        int recycled = pipelane_pool_recycle(&sim->pipelanes, sim->config.pipelane_spacing);
+        if(recycled >= 0)
+            flappy_bird_sim_place_opening(sim, (unsigned int)recycled);
+        flappy_bird_sim_draw_obstacles(sim, recycled >= 0);
+    }
+
+    // Check if the bird is colliding with either a pipelane, the ceiling or the ground, the sprite is tested against the obstacle layer one row at a time however many pipelanes there are
+    int bird_x = fixed_to_int(bird->xPosition);
+    int bird_y = fixed_to_int(bird->yPosition);
+    if(bird->yPosition < 0 || bird->yPosition > sim->config.floor ||
+        matrix_bitmap_test_mask(&sim->obstacles, bird_x, bird_y, bird->spriteRows, bird->spriteWidth, bird->spriteHeight))
+    {
+        sim->last_score = sim->score;
+        sim->crash_count++;
+        flappy_bird_sim_reset(sim);     // Reset the round after colliding with either a pipelane, the ceiling or the ground
+        return FLAPPY_BIRD_SIM_EVENT_CRASH;
+    }
+
+    // Check if the bird flew into the opening of a pipelane, a bird in the column of a pipelane that does not collide is in its opening, every opening scores once
+    int opening = pipelane_pool_find_column(&sim->pipelanes, bird_x, bird->spriteWidth);
+    if(opening >= 0 && !sim->pipelanes.hasScored[opening])
+    {
+        sim->pipelanes.hasScored[opening] = true;
+        sim->score++;
+        return FLAPPY_BIRD_SIM_EVENT_SCORE;
+    }
+    return 0;
+}
+
+// Draws the pipelanes and the bird of the game on [bitmap], the pipelanes are copied from the obstacle layer
+void flappy_bird_sim_draw(const flappy_bird_sim_t* sim, matrix_bitmap_t* bitmap)
+{
+    matrix_bitmap_clear(bitmap);
+    matrix_bitmap_copy_rect(bitmap, 0, 0, &sim->obstacles, 0, 0, (int)bitmap->width, (int)bitmap->height);
+
+    // The rows of the sprite are added to the pipelanes under them
+    const bird_t* bird = &sim->bird;
+    int bird_x = fixed_to_int(bird->xPosition);
+    int bird_y = fixed_to_int(bird->yPosition);
+    for(int i = 0; i < bird->spriteHeight; i++)
+        matrix_bitmap_set_bits(bitmap, bird_x, bird_y + i, bird->spriteWidth, matrix_bitmap_get_bits(bitmap, bird_x, bird_y + i, bird->spriteWidth) | bird->spriteRows[i]);
+}
\ No newline at end of file
@@ -6,24 +6,31 @@
 #ifndef BIRD_H
 #define BIRD_H
 
-#include "matrix_array.h"
+#include <stdint.h>
+
+#include "fixed_point.h"
 
 #ifdef __cplusplus
 extern "C" {
 #endif
 
-// Type representing a bird with its position, velocity and its downwards accelaration
+#define BIRD_SPRITE_MAX_HEIGHT 4    // Maximum ammount of rows of the sprite of a bird
+
+// Type representing a bird with its position, velocity, its downwards accelaration and the pixels it covers
 typedef struct
 {
-    float xPosition, yPosition;     // X and Y position of the bird
-    float yVelocity;                // Velocity of the bird on the Y axis
-    float yAcceleration;            // Acceleration of the bird on the Y axis
+    fixed_t xPosition, yPosition;   // X and Y position of the top left pixel of the bird in fixed-point pixels
+    fixed_t yRemainder;             // Part of the movement on the Y axis smaller than a fixed-point step, it is added to the position once it adds up
+    fixed_t yVelocity;              // Velocity of the bird on the Y axis in fixed-point pixels per step
+    fixed_t yAcceleration;          // Acceleration of the bird on the Y axis in fixed-point pixels per step per step
+    uint32_t spriteRows[BIRD_SPRITE_MAX_HEIGHT];    // Packed pixels of every row of the sprite, bit n is the pixel n columns right of the position, like the rows of a matrix_bitmap
+    int spriteWidth, spriteHeight;  // Width (at most 32) and height of the sprite in pixels
 } bird_t;
 
-// Draws the bird given to the function on the matrix array given to the function
-void bird_draw(bird_t** bird, matrix_array_t** matrix_array);
-// Updates the position and velocity of the bird
-void bird_update(bird_t** bird, float deltatime);
+// Updates the position and velocity of the bird, the bird follows the same path whatever the length of [deltatime] is
+void bird_update(bird_t** bird, fixed_t deltatime);
+// Sets the sprite of the bird to the packed [rows] of [width] (at most 32) x [height] (at most BIRD_SPRITE_MAX_HEIGHT) pixels
+void bird_set_sprite(bird_t** bird, const uint32_t* rows, int width, int height);
 
 #ifdef __cplusplus
 }
@@ -0,0 +1,59 @@
+/*
+    Author: Kenley Strik
+    Addition: This whole file was written by Kenley Strik
+*/
+
+#ifndef FIXED_POINT_H
+#define FIXED_POINT_H
+
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*
+    Fixed-point numbers with 8 fractional bits (Q8.8), stored in 32 bits so sums and products of game values
+    never overflow. Integer arithmetic gives the same results on the target and on the host, which deterministic
+    replays need, and a position converts to its pixel with a single shift
+*/
+typedef int32_t fixed_t;
+
+#define FIXED_POINT_FRACTION_BITS 8                         // Ammount of bits after the binary point
+#define FIXED_POINT_ONE (1 << FIXED_POINT_FRACTION_BITS)    // The fixed-point value of 1
+
+#define FIXED_FROM_INT(value) ((fixed_t)((value) * FIXED_POINT_ONE))     // Converts an integer to fixed-point
+// Converts a float constant to the nearest fixed-point value, meant for constants so the game never converts floats at runtime
+#define FIXED_FROM_FLOAT(value) ((fixed_t)((value) * FIXED_POINT_ONE + (((value) < 0) ? -0.5f : 0.5f)))
+
+// Returns the pixel a fixed-point position falls in, rounding down (GCC shifts signed values arithmetically) so positions just left of or above 0 are outside the matrix array
+static inline int fixed_to_int(fixed_t value)
+{
+    return (int)(value >> FIXED_POINT_FRACTION_BITS);
+}
+
+// Returns the product of two fixed-point values, the fraction of the result is rounded down
+static inline fixed_t fixed_mul(fixed_t a, fixed_t b)
+{
+    return (fixed_t)(((int64_t)a * b) >> FIXED_POINT_FRACTION_BITS);
+}
+
+// Adds [amount], which has twice the fractional bits like a product of two fixed-point values, to [value] and keeps the fraction that does not fit in [remainder], so many small steps add up to their exact sum
+static inline void fixed_add_product(fixed_t* value, fixed_t* remainder, int64_t amount)
+{
+    int64_t total = amount + *remainder;
+    *value += (fixed_t)(total >> FIXED_POINT_FRACTION_BITS);
+    *remainder = (fixed_t)(total & (FIXED_POINT_ONE - 1));
+}
+
+// Returns the quotient of two fixed-point values, [b] must not be 0
+static inline fixed_t fixed_div(fixed_t a, fixed_t b)
+{
+    return (fixed_t)(((int64_t)a * FIXED_POINT_ONE) / b);
+}
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif  // FIXED_POINT_H
\ No newline at end of file
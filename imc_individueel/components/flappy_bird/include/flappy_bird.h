@@ -7,32 +7,58 @@
 #define FLAPPY_BIRD_H
 
 #include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+#include "freertos/semphr.h"
 #include "freertos/event_groups.h"
+#include "esp_timer.h"
+#include "esp_system.h"
 
 #include <stdlib.h>
-#include <time.h>
+#include <string.h>
 
-#include "bird.h"
-#include "pipelane.h"
+#include "flappy_bird_sim.h"
+#include "flappy_bird_replay.h"
+#include "high_score.h"
 #include "matrix_array.h"
 #include "gpio_button.h"
 #include "buzzer.h"
+#include "frame_pacer.h"
+#include "fixed_step.h"
 
 #ifdef __cplusplus
 extern "C" {
 #endif
 
+// Type for representing the timing of the task running the game loop
+typedef struct
+{
+    unsigned long frame_count;      // Ammount of times the game loop ran
+    unsigned long overrun_count;    // Ammount of times the game loop took longer than its period
+    int64_t last_jitter;            // Time in microseconds the last interval between two runs of the game loop was off from the period
+    int64_t max_jitter;             // Largest time in microseconds an interval between two runs of the game loop was off from the period
+    int64_t last_loop_time;         // Time in microseconds the last run of the game loop took
+    int64_t max_loop_time;          // Longest time in microseconds a run of the game loop took
+} flappy_bird_stats_t;
+
 // Initializes the flappy bird game
 void flappy_bird_init();
 // Deinitializes the flappy bird game
 void flappy_bird_deinit();
 
-// Start the flappy bird game and the task that updates the game
-void flappy_bird_start();
+// Start the flappy bird game and the task that updates the game with priority [priority] pinned to core [core_id] (or tskNO_AFFINITY)
+void flappy_bird_start(UBaseType_t priority, BaseType_t core_id);
+// Starts playing the replay of [size] bytes at [data] instead of the button with the task that updates the game, the replay has to stay in memory until the game is stopped, returns false if it is not a replay or the game could not be started
+bool flappy_bird_start_replay(const uint8_t* data, size_t size, UBaseType_t priority, BaseType_t core_id);
+// Sets the function the games started after this are recorded with, it is called from the task that updates the game, NULL stops recording
+void flappy_bird_set_recording(flappy_bird_replay_write_t write, void* context);
 // Stops the flappy bird game and the task that updates the game
 void flappy_bird_stop();
 // Propels the bird upwards by setting a certain velocity in the opposite direction as gravity 
 void flappy_bird_flap();
+// Returns the timing of the task running the game loop since the game was started
+flappy_bird_stats_t flappy_bird_get_stats();
+// Stores a copy of the high score table and the statistics of the rounds played in [record]
+void flappy_bird_get_high_scores(high_score_record_t* record);
 
 #ifdef __cplusplus
 }
@@ -0,0 +1,79 @@
+/*
+    Author: Kenley Strik
+    Addition: This whole file was written by Kenley Strik
+*/
+
+#ifndef FLAPPY_BIRD_REPLAY_H
+#define FLAPPY_BIRD_REPLAY_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+
+#include "flappy_bird_sim.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*
+    Layout of a replay, every number is a varint (7 bits per byte, least significant group first, the high bit is set
+    on every byte but the last) and signed numbers are zigzag encoded first so small negative values stay short:
+    header      "FBRP", version (1 byte), seed, pipelane count, then signed: flap velocity, gravity, pipelane velocity,
+                pipelane spacing, opening size, lowest opening, highest opening, floor, deltatime
+    flaps       for every flap the ammount of steps since the last flap (or since the start), steps are counted from 1
+    end         0, then the ammount of steps after the last flap, a replay without an end was cut off
+*/
+#define FLAPPY_BIRD_REPLAY_MAGIC "FBRP"         // First bytes of every replay
+#define FLAPPY_BIRD_REPLAY_VERSION 2            // Version of the layout written by this version of flappy_bird_replay, version 2 places the openings with pcg_random
+#define FLAPPY_BIRD_REPLAY_MAX_HEADER_SIZE 60   // Maximum size in bytes of the header of a replay
+
+// Function the replay is written with, returns false when the bytes could not be written
+typedef bool (*flappy_bird_replay_write_t)(void* context, const uint8_t* data, size_t length);
+
+// Type for representing the recording of a game, the steps of the game are passed to it one by one
+typedef struct
+{
+    flappy_bird_replay_write_t write;       // Function the replay is written with
+    void* context;                          // Pointer passed to the write function, for example a FILE*
+    unsigned long step_count;               // Ammount of steps recorded
+    unsigned long last_flap_step;           // Step of the last flap that was recorded, 0 before the first flap
+    unsigned long flap_count;               // Ammount of flaps recorded
+    bool has_failed;                        // Boolean value for indicating if the write function failed, nothing is written after that
+    bool is_initialized;                    // Boolean value for indicating if the recorder is initialized
+} flappy_bird_recorder_t;
+
+// Type for representing the playback of a replay that is in memory
+typedef struct
+{
+    const uint8_t* data;                    // Bytes of the replay
+    size_t size;                            // Size in bytes of the replay
+    size_t position;                        // Position of the next byte that is read
+    flappy_bird_sim_config_t config;        // Rules the game of the replay was played with
+    unsigned int seed;                      // Seed the game of the replay was initialized with
+    unsigned long step_count;               // Ammount of steps played back
+    unsigned long next_flap_step;           // Step of the next flap, 0 when there are no flaps left
+    unsigned long end_step;                 // Step the replay ends at, known once the end of the replay is read
+    bool has_end;                           // Boolean value for indicating the end of the replay was read
+    bool is_initialized;                    // Boolean value for indicating if the player is initialized
+} flappy_bird_player_t;
+
+// Initializes the recorder given to the function and writes the header for a game initialized with [config] and [seed], returns false if the header could not be written
+bool flappy_bird_recorder_init(flappy_bird_recorder_t* recorder, const flappy_bird_sim_config_t* config, unsigned int seed, flappy_bird_replay_write_t write, void* context);
+// Writes the end of the replay and deinitializes the recorder given to the function
+void flappy_bird_recorder_deinit(flappy_bird_recorder_t* recorder);
+// Records the next step of the game, [flap] is the input the step was played with
+void flappy_bird_recorder_step(flappy_bird_recorder_t* recorder, bool flap);
+
+// Initializes the player given to the function with the replay of [size] bytes at [data], which has to stay in memory, returns false if it is not a replay
+bool flappy_bird_player_init(flappy_bird_player_t* player, const uint8_t* data, size_t size);
+// Initializes [sim] with the rules and seed of the replay, the game is then played back with flappy_bird_player_next, returns false if there was not enough memory
+bool flappy_bird_player_setup(flappy_bird_player_t* player, flappy_bird_sim_t* sim);
+// Stores the input of the next step in [flap], returns false if the replay has no steps left
+bool flappy_bird_player_next(flappy_bird_player_t* player, bool* flap);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif  // FLAPPY_BIRD_REPLAY_H
\ No newline at end of file
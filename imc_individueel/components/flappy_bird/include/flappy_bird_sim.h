@@ -0,0 +1,84 @@
+/*
+    Author: Kenley Strik
+    Addition: This whole file was written by Kenley Strik
+*/
+
+#ifndef FLAPPY_BIRD_SIM_H
+#define FLAPPY_BIRD_SIM_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stdlib.h>
+
+#include "bird.h"
+#include "pipelane_pool.h"
+#include "pcg_random.h"
+#include "matrix_bitmap.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define FLAPPY_BIRD_SIM_EVENT_SCORE 0x01        // The bird flew into the opening of a pipelane during the step
+#define FLAPPY_BIRD_SIM_EVENT_CRASH 0x02        // The bird hit a pipelane, the ceiling or the ground during the step and the round was reset
+#define FLAPPY_BIRD_SIM_WIDTH 8                 // Width in pixels of the matrix array the game is played on, the obstacles are kept for these columns
+#define FLAPPY_BIRD_SIM_RANDOM_STREAM 1         // Stream of the random generator placing the openings, other generators seeded with the seed of a game use another stream
+
+// Type for representing the rules of the game, every value can be changed for tuning without rebuilding the simulation
+typedef struct
+{
+    fixed_t flap_velocity;                  // Velocity of the bird after a flap in pixels per step
+    fixed_t gravity;                        // Downwards acceleration of the bird in pixels per step per step
+    unsigned int pipelane_count;            // Ammount of pipelanes in the world (at most PIPELANE_POOL_MAX_COUNT), a pipelane that leaves on the left is placed behind the last one
+    fixed_t pipelane_velocity;              // Velocity of the pipelanes in pixels per step
+    fixed_t pipelane_spacing;               // Distance between two pipelanes
+    fixed_t opening_size;                   // Size of the opening of a pipelane
+    int opening_min;                        // Lowest y position the middle of an opening is placed at
+    int opening_max;                        // Highest y position the middle of an opening is placed at
+    fixed_t floor;                          // Y position below which the bird has hit the ground
+    fixed_t deltatime;                      // Length of a step in the steps the velocities and accelerations are tuned for
+} flappy_bird_sim_config_t;
+
+/*
+    Type for representing the state of one game, everything the rules need is in here so any ammount of games
+    can be simulated next to each other on any thread. Two games with the same config, seed and inputs stay the
+    same step for step. The pipelanes are drawn on the obstacle layer whenever they reach another column, the bird collides
+    by testing the rows of its sprite against that layer and the drawing of the game starts from a copy of it
+*/
+typedef struct
+{
+    flappy_bird_sim_config_t config;        // Rules the game is played with
+    bird_t bird;                            // The bird
+    pipelane_pool_t pipelanes;              // The pipelanes the bird flies through
+    matrix_bitmap_t obstacles;              // Packed layer with the pipes of the pipelanes, every row the bird can be in down to the floor
+    int drawn_columns[PIPELANE_POOL_MAX_COUNT];     // Column every pipelane is drawn at on the obstacle layer, the layer is drawn again when one changes
+    unsigned int seed;                      // Seed the game was initialized with
+    pcg_random_t random;                    // Random generator placing the openings
+    bool is_started;                        // Boolean value for indicating the first flap of the round happened, the world stands still until then
+
+    unsigned long step_count;               // Ammount of steps simulated since the game was initialized
+    unsigned int score;                     // Ammount of openings the bird flew through during this round
+    unsigned int last_score;                // Score of the round that ended with the last crash
+    unsigned long crash_count;              // Ammount of rounds that ended with a crash
+} flappy_bird_sim_t;
+
+// Stores the rules of the game on the matrix array of two vertical displays in [config]
+void flappy_bird_sim_default_config(flappy_bird_sim_config_t* config);
+
+// Initializes the game given to the function with the rules of [config] and the random generator at [seed], and sets up the first round, returns false if there was not enough memory
+bool flappy_bird_sim_init(flappy_bird_sim_t* sim, const flappy_bird_sim_config_t* config, unsigned int seed);
+// Releases the memory of the game
+void flappy_bird_sim_deinit(flappy_bird_sim_t* sim);
+// Sets up a new round, the bird and pipelanes go back to their start positions and the world waits for the first flap
+void flappy_bird_sim_reset(flappy_bird_sim_t* sim);
+
+// Advances the game by one step, [flap] propels the bird upwards first, returns the FLAPPY_BIRD_SIM_EVENT flags of what happened
+unsigned int flappy_bird_sim_step(flappy_bird_sim_t* sim, bool flap);
+// Draws the pipelanes and the bird of the game on [bitmap], the pipelanes are copied from the obstacle layer
+void flappy_bird_sim_draw(const flappy_bird_sim_t* sim, matrix_bitmap_t* bitmap);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif  // FLAPPY_BIRD_SIM_H
\ No newline at end of file
@@ -0,0 +1,61 @@
+/*
+    Author: Kenley Strik
+    Addition: This whole file was written by Kenley Strik
+*/
+
+#ifndef PCG_RANDOM_H
+#define PCG_RANDOM_H
+
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*
+    Random generator of the PCG family (PCG32, XSH RR), the state is 64 bits and every number is 32 bits. Every
+    generator is its own, so games on different tasks or threads never share or lock a generator, and a generator
+    seeded the same way gives the same numbers on the target and on the host. Generators seeded alike but on a
+    different stream give numbers that are independent of each other
+*/
+typedef struct
+{
+    uint64_t state;                         // State of the generator, advanced by every number
+    uint64_t increment;                     // Increment of the generator, odd and different for every stream
+} pcg_random_t;
+
+#define PCG_RANDOM_MULTIPLIER 6364136223846793005ULL    // Multiplier of the linear congruential step of PCG32
+
+// Returns the next 32 bit random number of [random]
+static inline uint32_t pcg_random_next(pcg_random_t* random)
+{
+    uint64_t state = random->state;
+    random->state = state * PCG_RANDOM_MULTIPLIER + random->increment;
+
+    // The output is a permutation of the old state, the highest bits pick the rotation of the xorshifted bits
+    uint32_t xorshifted = (uint32_t)(((state >> 18) ^ state) >> 27);
+    uint32_t rotation = (uint32_t)(state >> 59);
+    return (xorshifted >> rotation) | (xorshifted << ((32 - rotation) & 31));
+}
+
+// Seeds [random] with [seed] on [stream], the same seed and stream always give the same numbers
+static inline void pcg_random_seed(pcg_random_t* random, uint64_t seed, uint64_t stream)
+{
+    random->state = 0;
+    random->increment = (stream << 1) | 1;
+    pcg_random_next(random);
+    random->state += seed;
+    pcg_random_next(random);
+}
+
+// Returns a random number from 0 up to but not including [bound], scaled with a multiply instead of a division, the bias is at most bound / 2^32
+static inline uint32_t pcg_random_below(pcg_random_t* random, uint32_t bound)
+{
+    return (uint32_t)(((uint64_t)pcg_random_next(random) * bound) >> 32);
+}
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif  // PCG_RANDOM_H
\ No newline at end of file
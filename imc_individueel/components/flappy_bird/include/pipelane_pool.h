@@ -0,0 +1,62 @@
+/*
+    Author: Kenley Strik
+    Addition: This whole file was written by Kenley Strik
+*/
+
+#ifndef PIPELANE_POOL_H
+#define PIPELANE_POOL_H
+
+#include <stdbool.h>
+
+#include "fixed_point.h"
+#include "matrix_bitmap.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define PIPELANE_POOL_MAX_COUNT 32          // Maximum ammount of pipelanes in a pool, enough to fill a wall of matrix displays
+
+/*
+    Type for representing all the pipelanes of a game, every property is stored in its own array so updating,
+    drawing and checking the pipelanes runs over contiguous memory. The pipelanes are kept from left to right in a
+    ring starting at [first], the pipelane that leaves on the left is recycled behind the last one without moving
+    any of the others
+*/
+typedef struct
+{
+    fixed_t xPositions[PIPELANE_POOL_MAX_COUNT];        // X position of every pipelane in fixed-point pixels
+    fixed_t openingYPositions[PIPELANE_POOL_MAX_COUNT]; // Y position of the middle of the opening of every pipelane
+    int openingTops[PIPELANE_POOL_MAX_COUNT];           // First row of the opening of every pipelane, calculated when the opening is set
+    int openingBottoms[PIPELANE_POOL_MAX_COUNT];        // Last row of the opening of every pipelane, calculated when the opening is set
+    bool hasScored[PIPELANE_POOL_MAX_COUNT];            // Boolean value for every pipelane indicating the bird flew through its opening since it was placed
+    fixed_t openingSize;                    // Size of the openings
+    fixed_t xRemainder;                     // Part of the movement of the pipelanes smaller than a fixed-point step, it is added to the positions once it adds up
+    unsigned int count;                     // Ammount of pipelanes in the pool
+    unsigned int first;                     // Index of the leftmost pipelane
+} pipelane_pool_t;
+
+// Initializes the pool given to the function with [count] pipelanes (at most PIPELANE_POOL_MAX_COUNT) from [x_position] to the right at [spacing], with openings of [opening_size]
+void pipelane_pool_init(pipelane_pool_t* pool, unsigned int count, fixed_t x_position, fixed_t spacing, fixed_t opening_size);
+// Sets the opening of pipelane [index] around [y_position] and calculates the rows it spans, the opening can be scored again
+void pipelane_pool_set_opening(pipelane_pool_t* pool, unsigned int index, fixed_t y_position);
+// Returns the index of the pipelane that is [order] places from the left
+unsigned int pipelane_pool_get_index(const pipelane_pool_t* pool, unsigned int order);
+
+// Moves all the pipelanes with [xVelocity] for [deltatime]
+void pipelane_pool_update(pipelane_pool_t* pool, fixed_t xVelocity, fixed_t deltatime);
+// Moves the leftmost pipelane to [spacing] behind the last one if it left on the left side, returns its index or -1 if no pipelane left
+int pipelane_pool_recycle(pipelane_pool_t* pool, fixed_t spacing);
+
+// Returns the index of the first pipelane in the [width] columns starting at column [x], or -1 if there is none
+int pipelane_pool_find_column(const pipelane_pool_t* pool, int x, int width);
+// Draws pipelane [index] on [bitmap], the pipes above and below the opening are drawn as a column
+void pipelane_pool_draw_pipelane(const pipelane_pool_t* pool, unsigned int index, matrix_bitmap_t* bitmap);
+// Draws all the pipelanes on [bitmap], the pipes above and below every opening are drawn as columns, which is also the layer the pipelanes are collided with
+void pipelane_pool_draw(const pipelane_pool_t* pool, matrix_bitmap_t* bitmap);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif  // PIPELANE_POOL_H
\ No newline at end of file
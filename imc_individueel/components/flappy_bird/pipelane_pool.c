@@ -0,0 +1,87 @@
+/*
+    Author: Kenley Strik
+    Addition: This whole file was written by Kenley Strik
+*/
+
+#include "include/pipelane_pool.h"
+
+// Initializes the pool given to the function with [count] pipelanes (at most PIPELANE_POOL_MAX_COUNT) from [x_position] to the right at [spacing], with openings of [opening_size]
+void pipelane_pool_init(pipelane_pool_t* pool, unsigned int count, fixed_t x_position, fixed_t spacing, fixed_t opening_size)
+{
+    pool->count = (count < PIPELANE_POOL_MAX_COUNT) ? count : PIPELANE_POOL_MAX_COUNT;
+    pool->first = 0;
+    pool->openingSize = opening_size;
+    pool->xRemainder = 0;
+    for(unsigned int i = 0; i < pool->count; i++)
+    {
+        pool->xPositions[i] = x_position + (fixed_t)i * spacing;
+        pipelane_pool_set_opening(pool, i, 0);
+    }
+}
+
+// Sets the opening of pipelane [index] around [y_position] and calculates the rows it spans, the opening can be scored again
+void pipelane_pool_set_opening(pipelane_pool_t* pool, unsigned int index, fixed_t y_position)
+{
+    pool->openingYPositions[index] = y_position;
+    pool->openingTops[index] = fixed_to_int(y_position - pool->openingSize / 2);       // Rows above the opening are part of the upper pipe
+    pool->openingBottoms[index] = fixed_to_int(y_position + pool->openingSize / 2);    // Rows below the opening are part of the lower pipe
+    pool->hasScored[index] = false;
+}
+
+// Returns the index of the pipelane that is [order] places from the left
+unsigned int pipelane_pool_get_index(const pipelane_pool_t* pool, unsigned int order)
+{
+    unsigned int index = pool->first + order;
+    return (index < pool->count) ? index : index - pool->count;
+}
+
+// Moves all the pipelanes with [xVelocity] for [deltatime]
+void pipelane_pool_update(pipelane_pool_t* pool, fixed_t xVelocity, fixed_t deltatime)
+{
+    // The pipelanes move together, so the distance is calculated once, the part of it smaller than a fixed-point step is kept for the next update
+    fixed_t distance = 0;
+    fixed_add_product(&distance, &pool->xRemainder, (int64_t)xVelocity * deltatime);
+    for(unsigned int i = 0; i < pool->count; i++)
+        pool->xPositions[i] += distance;
+}
+
+// Moves the leftmost pipelane to [spacing] behind the last one if it left on the left side, returns its index or -1 if no pipelane left
+int pipelane_pool_recycle(pipelane_pool_t* pool, fixed_t spacing)
+{
+    // The pipelanes move together, so only the leftmost one can have left
+    if(pool->count == 0 || pool->xPositions[pool->first] >= 0)
+        return -1;
+
+    unsigned int index = pool->first;
+    unsigned int last = pipelane_pool_get_index(pool, pool->count - 1);
+    pool->xPositions[index] = pool->xPositions[last] + spacing;
+    pool->first = pipelane_pool_get_index(pool, 1);     // The next pipelane is the leftmost one now
+    return (int)index;
+}
+
+// Returns the index of the first pipelane in the [width] columns starting at column [x], or -1 if there is none
+int pipelane_pool_find_column(const pipelane_pool_t* pool, int x, int width)
+{
+    for(unsigned int i = 0; i < pool->count; i++)
+    {
+        int column = fixed_to_int(pool->xPositions[i]);
+        if(column >= x && column < x + width)
+            return (int)i;
+    }
+    return -1;
+}
+
+// Draws pipelane [index] on [bitmap], the pipes above and below the opening are drawn as a column
+void pipelane_pool_draw_pipelane(const pipelane_pool_t* pool, unsigned int index, matrix_bitmap_t* bitmap)
+{
+    int x = fixed_to_int(pool->xPositions[index]);
+    matrix_bitmap_draw_vline(bitmap, x, 0, pool->openingTops[index], true);
+    matrix_bitmap_draw_vline(bitmap, x, pool->openingBottoms[index] + 1, (int)bitmap->height - pool->openingBottoms[index] - 1, true);
+}
+
+// Draws all the pipelanes on [bitmap], the pipes above and below every opening are drawn as columns, which is also the layer the pipelanes are collided with
+void pipelane_pool_draw(const pipelane_pool_t* pool, matrix_bitmap_t* bitmap)
+{
+    for(unsigned int i = 0; i < pool->count; i++)
+        pipelane_pool_draw_pipelane(pool, i, bitmap);
+}
\ No newline at end of file
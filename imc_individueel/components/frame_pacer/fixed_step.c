@@ -0,0 +1,66 @@
+/*
+    Author: Kenley Strik
+    Addition: This whole file was written by Kenley Strik
+*/
+
+#include "include/fixed_step.h"
+
+// Initializes the accumulator given to the function for [step_rate] steps per second, handing out at most [max_steps] steps at once
+void fixed_step_init(fixed_step_t* fixed_step, unsigned int step_rate, unsigned int max_steps)
+{
+    // Check if accumulator is initialized and if not initialize it, a step rate of 0 is treated as 1 and at least one step is handed out
+    if(!fixed_step->is_initialized)
+    {
+        fixed_step->step_interval = 1000000 / ((step_rate > 0) ? step_rate : 1);
+        fixed_step->max_steps = (max_steps > 0) ? max_steps : 1;
+        fixed_step->is_initialized = true;
+        fixed_step_reset(fixed_step);
+    }
+}
+
+// Empties the accumulator and starts collecting time from now
+void fixed_step_reset(fixed_step_t* fixed_step)
+{
+    // Check if accumulator is initialized
+    if(fixed_step->is_initialized)
+    {
+        fixed_step->accumulator = 0;
+        fixed_step->last_time = esp_timer_get_time();
+        fixed_step->step_count = 0;
+        fixed_step->dropped_steps = 0;
+    }
+}
+
+// Collects the time that passed since the last call and returns the ammount of whole steps that are due
+unsigned int fixed_step_advance(fixed_step_t* fixed_step)
+{
+    // Check if accumulator is initialized
+    if(!fixed_step->is_initialized)
+        return 0;
+
+    int64_t now = esp_timer_get_time();
+    fixed_step->accumulator += now - fixed_step->last_time;
+    fixed_step->last_time = now;
+
+    int64_t steps = fixed_step->accumulator / fixed_step->step_interval;
+    fixed_step->accumulator -= steps * fixed_step->step_interval;
+
+    // Drop the steps beyond the maximum, catching up on a long stall would make the next call stall even longer
+    if(steps > fixed_step->max_steps)
+    {
+        fixed_step->dropped_steps += (unsigned long)(steps - fixed_step->max_steps);
+        steps = fixed_step->max_steps;
+    }
+    fixed_step->step_count += (unsigned long)steps;
+    return (unsigned int)steps;
+}
+
+// Returns how far (0 to 1) the time in the accumulator is into the next step
+float fixed_step_get_alpha(fixed_step_t* fixed_step)
+{
+    // Check if accumulator is initialized
+    if(!fixed_step->is_initialized)
+        return 0.0f;
+
+    return (float)fixed_step->accumulator / (float)fixed_step->step_interval;
+}
\ No newline at end of file
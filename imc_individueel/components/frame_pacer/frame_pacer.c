@@ -0,0 +1,120 @@
+/*
+    Author: Kenley Strik
+    Addition: This whole file was written by Kenley Strik
+*/
+
+#include "include/frame_pacer.h"
+
+// Initializes the frame pacer given to the function for a target frame rate of [target_fps] frames per second
+void frame_pacer_init(frame_pacer_t* pacer, unsigned int target_fps)
+{
+    // Check if frame pacer is initialized and if not initialize it
+    if(!pacer->is_initialized)
+    {
+        pacer->is_initialized = true;
+        frame_pacer_set_target_fps(pacer, target_fps);
+
+        int64_t now = esp_timer_get_time();
+        pacer->next_frame_time = now;               // First frame is due immediately
+        pacer->frame_start_time = now;
+        pacer->presented_frames = 0;
+        pacer->dropped_frames = 0;
+        pacer->achieved_fps = 0.0f;
+        pacer->fps_window_start = now;
+        pacer->fps_window_frames = 0;
+        pacer->flush_time_index = 0;
+        pacer->flush_time_count = 0;
+    }
+}
+
+// Changes the target frame rate of the frame pacer to [target_fps] frames per second
+void frame_pacer_set_target_fps(frame_pacer_t* pacer, unsigned int target_fps)
+{
+    // Check if frame pacer is initialized, a target of 0 frames per second is treated as 1
+    if(pacer->is_initialized)
+        pacer->frame_interval = 1000000 / ((target_fps > 0) ? target_fps : 1);
+}
+
+// Checks if a frame is due, returns true if the frame must be drawn and flushed and false if the tick must be merged into the next frame
+bool frame_pacer_begin_frame(frame_pacer_t* pacer)
+{
+    // Check if frame pacer is initialized
+    if(!pacer->is_initialized)
+        return true;
+
+    int64_t now = esp_timer_get_time();
+    if(now < pacer->next_frame_time)
+        return false;
+
+    pacer->frame_start_time = now;
+    return true;
+}
+
+// Ends the frame that was started by frame_pacer_begin_frame and records the time in microseconds it took to flush it
+void frame_pacer_end_frame(frame_pacer_t* pacer, int64_t flush_time)
+{
+    // Check if frame pacer is initialized
+    if(pacer->is_initialized)
+    {
+        int64_t now = esp_timer_get_time();
+
+        // Store the flush time in the ring buffer, overwriting the oldest flush time when it is full
+        pacer->flush_times[pacer->flush_time_index] = flush_time;
+        pacer->flush_time_index = (pacer->flush_time_index + 1) % FRAME_PACER_SAMPLE_COUNT;
+        if(pacer->flush_time_count < FRAME_PACER_SAMPLE_COUNT)
+            pacer->flush_time_count++;
+
+        pacer->presented_frames++;
+        pacer->fps_window_frames++;
+
+        // Schedule the next frame one interval after this one, frame slots that already passed during the flush are dropped
+        pacer->next_frame_time += pacer->frame_interval;
+        if(pacer->next_frame_time < pacer->frame_start_time)
+        {
+            // The frame slots that passed before this frame started are dropped instead of caught up
+            int64_t skipped_frames = (pacer->frame_start_time - pacer->next_frame_time) / pacer->frame_interval + 1;
+            pacer->dropped_frames += (unsigned int)skipped_frames;
+            pacer->next_frame_time += skipped_frames * pacer->frame_interval;
+        }
+        if(pacer->next_frame_time <= now)
+        {
+            int64_t missed_frames = (now - pacer->next_frame_time) / pacer->frame_interval + 1;
+            pacer->dropped_frames += (unsigned int)missed_frames;
+            pacer->next_frame_time += missed_frames * pacer->frame_interval;
+        }
+
+        // Calculate the achieved frame rate once every second
+        if(now - pacer->fps_window_start >= 1000000)
+        {
+            pacer->achieved_fps = (float)pacer->fps_window_frames * 1000000.0f / (float)(now - pacer->fps_window_start);
+            pacer->fps_window_start = now;
+            pacer->fps_window_frames = 0;
+        }
+    }
+}
+
+// Returns the flush time in microseconds below which [percentile] percent of the recent flush times are
+int64_t frame_pacer_get_flush_time_percentile(frame_pacer_t* pacer, unsigned int percentile)
+{
+    // Check if frame pacer is initialized and has flush times
+    if(!pacer->is_initialized || pacer->flush_time_count == 0)
+        return 0;
+
+    // Sort a copy of the flush times with insertion sort, the ring buffer is small
+    int64_t sorted[FRAME_PACER_SAMPLE_COUNT];
+    unsigned int count = pacer->flush_time_count;
+    memcpy(sorted, pacer->flush_times, sizeof(int64_t) * count);
+    for(unsigned int i = 1; i < count; i++)
+    {
+        int64_t value = sorted[i];
+        unsigned int j = i;
+        for(; j > 0 && sorted[j - 1] > value; j--)
+            sorted[j] = sorted[j - 1];
+        sorted[j] = value;
+    }
+
+    if(percentile > 100)
+        percentile = 100;
+    unsigned int index = (percentile * (count - 1) + 50) / 100;     // Nearest rank
+    return sorted[index];
+}
\ No newline at end of file
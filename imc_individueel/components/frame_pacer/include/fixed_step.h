@@ -0,0 +1,49 @@
+/*
+    Author: Kenley Strik
+    Addition: This whole file was written by Kenley Strik
+*/
+
+#ifndef FIXED_STEP_H
+#define FIXED_STEP_H
+
+#include "esp_timer.h"
+
+#include <stdint.h>
+#include <stdbool.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*
+    Type for representing a fixed timestep accumulator, the time that passed between two calls is collected
+    and handed out as whole simulation steps of the same length, so the simulation does not depend on how often
+    or how regularly it is called. The remainder stays in the accumulator for the next call
+*/
+typedef struct
+{
+    int64_t step_interval;                  // Length of one simulation step in microseconds
+    int64_t accumulator;                    // Time in microseconds that passed and was not handed out as steps yet
+    int64_t last_time;                      // Time in microseconds at which time was last collected
+    unsigned int max_steps;                 // Maximum ammount of steps handed out at once, time beyond that is dropped so a stall does not snowball
+
+    unsigned long step_count;               // Ammount of steps handed out since the accumulator was reset
+    unsigned long dropped_steps;            // Ammount of steps dropped because more than [max_steps] were due at once
+    bool is_initialized;                    // Boolean value for indicating if the accumulator is initialized
+} fixed_step_t;
+
+// Initializes the accumulator given to the function for [step_rate] steps per second, handing out at most [max_steps] steps at once
+void fixed_step_init(fixed_step_t* fixed_step, unsigned int step_rate, unsigned int max_steps);
+// Empties the accumulator and starts collecting time from now, for example when the simulation was paused
+void fixed_step_reset(fixed_step_t* fixed_step);
+
+// Collects the time that passed since the last call and returns the ammount of whole steps that are due
+unsigned int fixed_step_advance(fixed_step_t* fixed_step);
+// Returns how far (0 to 1) the time in the accumulator is into the next step, for drawing between two steps
+float fixed_step_get_alpha(fixed_step_t* fixed_step);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif  // FIXED_STEP_H
\ No newline at end of file
@@ -0,0 +1,60 @@
+/*
+    Author: Kenley Strik
+    Addition: This whole file was written by Kenley Strik
+*/
+
+#ifndef FRAME_PACER_H
+#define FRAME_PACER_H
+
+#include "esp_timer.h"
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <string.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define FRAME_PACER_SAMPLE_COUNT 64     // Number of most recent flush times kept for the percentiles
+
+/*
+    Type for representing a frame pacer that decides when a frame is due for a target frame rate,
+    frames that can not be flushed in time are dropped and the ticks in between are merged into the next frame
+*/
+typedef struct
+{
+    int64_t frame_interval;                         // Target time between the start of two frames in microseconds
+    int64_t next_frame_time;                        // Time in microseconds at which the next frame is due
+    int64_t frame_start_time;                       // Time in microseconds at which the current frame was started
+
+    unsigned int presented_frames;                  // Ammount of frames that were drawn and flushed
+    unsigned int dropped_frames;                    // Ammount of frames that were skipped because the previous flush took too long
+    float achieved_fps;                             // Frames per second presented during the last whole second
+    int64_t fps_window_start;                       // Time in microseconds at which the current second for counting frames started
+    unsigned int fps_window_frames;                 // Ammount of frames presented in the current second
+
+    int64_t flush_times[FRAME_PACER_SAMPLE_COUNT];  // Ring buffer with the most recent flush times in microseconds
+    unsigned int flush_time_index;                  // Index in the ring buffer where the next flush time is stored
+    unsigned int flush_time_count;                  // Ammount of flush times in the ring buffer
+    bool is_initialized;                            // Boolean value for indicating if the frame pacer is initialized
+} frame_pacer_t;
+
+// Initializes the frame pacer given to the function for a target frame rate of [target_fps] frames per second
+void frame_pacer_init(frame_pacer_t* pacer, unsigned int target_fps);
+// Changes the target frame rate of the frame pacer to [target_fps] frames per second
+void frame_pacer_set_target_fps(frame_pacer_t* pacer, unsigned int target_fps);
+
+// Checks if a frame is due, returns true if the frame must be drawn and flushed and false if the tick must be merged into the next frame
+bool frame_pacer_begin_frame(frame_pacer_t* pacer);
+// Ends the frame that was started by frame_pacer_begin_frame and records the time in microseconds it took to flush it
+void frame_pacer_end_frame(frame_pacer_t* pacer, int64_t flush_time);
+
+// Returns the flush time in microseconds below which [percentile] percent of the recent flush times are
+int64_t frame_pacer_get_flush_time_percentile(frame_pacer_t* pacer, unsigned int percentile);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif  // FRAME_PACER_H
\ No newline at end of file
@@ -0,0 +1,238 @@
+/*
+    Author: Kenley Strik
+    Addition: This whole file was written by Kenley Strik
+*/
+
+#include "include/high_score.h"
+#include "include/high_score_storage.h"
+
+#include <string.h>
+
+static const uint32_t HIGH_SCORE_TASK_STACK_SIZE = 3072;
+static const unsigned int HIGH_SCORE_WRITE_DELAY = 2000;       // Time in milliseconds the task waits after a change before writing, the changes made meanwhile are written together
+static const unsigned int HIGH_SCORE_MAX_WRITE_DELAY = 10000;  // Time in milliseconds after the first change the record is written at the latest, however often it changes
+
+void high_score_task(void* arg);
+
+// Writes the record if it changed since it was last written, the record is copied so the mutex is not held while writing
+static void high_score_write(high_score_t* scores)
+{
+    high_score_record_t record;
+    xSemaphoreTake(scores->mutex, portMAX_DELAY);
+    bool is_dirty = scores->is_dirty;
+    record = scores->record;
+    scores->is_dirty = false;
+    xSemaphoreGive(scores->mutex);
+    if(!is_dirty)
+        return;
+
+    bool is_written = high_score_storage_save(scores->name, &record, sizeof(record));
+
+    xSemaphoreTake(scores->mutex, portMAX_DELAY);
+    scores->write_count++;
+    if(!is_written)
+    {
+        scores->failed_write_count++;
+        scores->is_dirty = true;    // Write the record again with the next change
+    }
+    xSemaphoreGive(scores->mutex);
+}
+
+// Marks the record as changed and wakes the task writing it, the mutex has to be taken
+static void high_score_mark_changed(high_score_t* scores)
+{
+    scores->is_dirty = true;
+    scores->change_count++;
+    xTaskNotifyGive(scores->task_handle);
+}
+
+// Returns true if the task writing the record has to stop
+static bool high_score_is_stopping(high_score_t* scores)
+{
+    xSemaphoreTake(scores->mutex, portMAX_DELAY);
+    bool is_stopping = scores->is_stopping;
+    xSemaphoreGive(scores->mutex);
+    return is_stopping;
+}
+
+// Returns true if the task may write the record now, what is left is always written when the task stops
+static bool high_score_is_write_allowed(high_score_t* scores)
+{
+    xSemaphoreTake(scores->mutex, portMAX_DELAY);
+    bool is_write_allowed = scores->is_write_allowed || scores->is_stopping;
+    xSemaphoreGive(scores->mutex);
+    return is_write_allowed;
+}
+
+// Adds a round that ended with [score] after [steps] steps to [stats]
+static void high_score_add_round(high_score_stats_t* stats, uint32_t score, uint32_t steps)
+{
+    stats->rounds++;
+    stats->score_total += score;
+    stats->steps += steps;
+    if(score > stats->best_score)
+        stats->best_score = score;
+}
+
+// Initializes the high score table given to the function with the record stored under [name] and starts the task writing it with priority [priority] pinned to core [core_id] (or tskNO_AFFINITY), returns false if the task could not be started
+bool high_score_init(high_score_t* scores, const char* name, UBaseType_t priority, BaseType_t core_id)
+{
+    // Check if high score table is initialized and if not initialize it
+    if(!scores->is_initialized)
+    {
+        scores->name = name;
+        scores->is_dirty = false;
+        scores->change_count = 0;
+        scores->write_count = 0;
+        scores->failed_write_count = 0;
+
+        // Start with an empty record if nothing or a record of another version is stored
+        if(!high_score_storage_load(name, &scores->record, sizeof(high_score_record_t)) || scores->record.version != HIGH_SCORE_VERSION ||
+            scores->record.entry_count > HIGH_SCORE_TABLE_SIZE)
+        {
+            memset(&scores->record, 0, sizeof(high_score_record_t));
+            scores->record.version = HIGH_SCORE_VERSION;
+        }
+
+        scores->mutex = xSemaphoreCreateMutex();
+        scores->stopped_semaphore = xSemaphoreCreateBinary();
+        scores->is_stopping = false;
+        scores->is_write_allowed = true;
+        if(scores->mutex == NULL || scores->stopped_semaphore == NULL ||
+            xTaskCreatePinnedToCore(&high_score_task, "high_score", HIGH_SCORE_TASK_STACK_SIZE, scores, priority, &scores->task_handle, core_id) != pdPASS)
+        {
+            if(scores->mutex != NULL)
+                vSemaphoreDelete(scores->mutex);
+            if(scores->stopped_semaphore != NULL)
+                vSemaphoreDelete(scores->stopped_semaphore);
+            return false;
+        }
+
+        scores->is_initialized = true;
+    }
+    return true;
+}
+
+// Writes the changes that were not written yet, stops the task and deinitializes the high score table given to the function
+void high_score_deinit(high_score_t* scores)
+{
+    // Check if high score table is initialized
+    if(scores->is_initialized)
+    {
+        // The task writes what is left before it stops
+        xSemaphoreTake(scores->mutex, portMAX_DELAY);
+        scores->is_stopping = true;
+        xTaskNotifyGive(scores->task_handle);
+        xSemaphoreGive(scores->mutex);
+        xSemaphoreTake(scores->stopped_semaphore, portMAX_DELAY);
+
+        vSemaphoreDelete(scores->stopped_semaphore);
+        vSemaphoreDelete(scores->mutex);
+        scores->is_initialized = false;
+    }
+}
+
+// Starts a new session, the statistics of the session start from nothing, the new session is written with the next change
+void high_score_begin_session(high_score_t* scores)
+{
+    // Check if high score table is initialized
+    if(scores->is_initialized)
+    {
+        // Not marked as changed, a session without rounds is not worth a write of the flash
+        xSemaphoreTake(scores->mutex, portMAX_DELAY);
+        scores->record.session_count++;
+        memset(&scores->record.session, 0, sizeof(high_score_stats_t));
+        xSemaphoreGive(scores->mutex);
+    }
+}
+
+// Allows or forbids the task to write the record, a change made while writing is forbidden is written some time after writing is allowed again
+void high_score_allow_writes(high_score_t* scores, bool is_allowed)
+{
+    // Check if high score table is initialized
+    if(scores->is_initialized)
+    {
+        xSemaphoreTake(scores->mutex, portMAX_DELAY);
+        if(is_allowed && !scores->is_write_allowed && scores->is_dirty)
+            xTaskNotifyGive(scores->task_handle);     // Start the write delay for the changes that were held back
+        scores->is_write_allowed = is_allowed;
+        xSemaphoreGive(scores->mutex);
+    }
+}
+
+// Adds a round that ended with [score] after [steps] steps, returns its place in the table counted from 0 or -1 if it did not make the table, the record is written later
+int high_score_submit(high_score_t* scores, uint32_t score, uint32_t steps)
+{
+    // Check if high score table is initialized
+    if(!scores->is_initialized)
+        return -1;
+
+    xSemaphoreTake(scores->mutex, portMAX_DELAY);
+    high_score_record_t* record = &scores->record;
+    high_score_add_round(&record->session, score, steps);
+    high_score_add_round(&record->lifetime, score, steps);
+
+    // Find the place of the score below the scores that are at least as high, a round without a score does not make the table
+    int place = -1;
+    if(score > 0)
+    {
+        unsigned int index = record->entry_count;
+        while(index > 0 && record->entries[index - 1].score < score)
+            index--;
+
+        if(index < HIGH_SCORE_TABLE_SIZE)
+        {
+            // Move the lower scores down a place, the lowest one drops off a full table
+            unsigned int moved = ((record->entry_count < HIGH_SCORE_TABLE_SIZE) ? record->entry_count : HIGH_SCORE_TABLE_SIZE - 1) - index;
+            memmove(&record->entries[index + 1], &record->entries[index], moved * sizeof(high_score_entry_t));
+            record->entries[index].score = score;
+            record->entries[index].steps = steps;
+            record->entries[index].session = record->session_count;
+            if(record->entry_count < HIGH_SCORE_TABLE_SIZE)
+                record->entry_count++;
+            place = (int)index;
+        }
+    }
+
+    high_score_mark_changed(scores);
+    xSemaphoreGive(scores->mutex);
+    return place;
+}
+
+// Stores a copy of the record in memory in [record], the changes that were not written yet are part of it
+void high_score_get_record(high_score_t* scores, high_score_record_t* record)
+{
+    // Check if high score table is initialized
+    if(scores->is_initialized)
+    {
+        xSemaphoreTake(scores->mutex, portMAX_DELAY);
+        *record = scores->record;
+        xSemaphoreGive(scores->mutex);
+    }
+}
+
+// Function for the task writing the record, it waits for a change and writes the record when no change has come in for the write delay and writing is allowed
+void high_score_task(void* arg)
+{
+    high_score_t* scores = (high_score_t*)arg;
+    TickType_t delay = pdMS_TO_TICKS(HIGH_SCORE_WRITE_DELAY);
+    TickType_t max_delay = pdMS_TO_TICKS(HIGH_SCORE_MAX_WRITE_DELAY);
+
+    while(!high_score_is_stopping(scores))
+    {
+        ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
+        TickType_t first_change_time = xTaskGetTickCount();
+
+        // Every change during the delay starts the delay again so a burst of changes ends up in one write, until the maximum delay has passed
+        while(!high_score_is_stopping(scores) && (TickType_t)(xTaskGetTickCount() - first_change_time) < max_delay && ulTaskNotifyTake(pdTRUE, delay) > 0)
+            ;
+
+        // While writing is forbidden the record stays changed, allowing writes wakes the task again
+        if(high_score_is_write_allowed(scores))
+            high_score_write(scores);
+    }
+    high_score_write(scores);   // Write what changed since the last write before stopping
+
+    xSemaphoreGive(scores->stopped_semaphore);  // Report the task has stopped
+    vTaskDelete(NULL);  // Delete the task, it is not needed anymore
+}
\ No newline at end of file
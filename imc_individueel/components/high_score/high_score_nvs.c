@@ -0,0 +1,38 @@
+/*
+    Author: Kenley Strik
+    Addition: This whole file was written by Kenley Strik
+*/
+
+#include "include/high_score_storage.h"
+
+#include "nvs.h"
+
+static const char* HIGH_SCORE_NVS_NAMESPACE = "high_score";    // NVS namespace the records are stored in, nvs_flash_init has to be called before
+
+// Reads the [size] bytes stored under [name] into [data], returns false if nothing of that size is stored
+bool high_score_storage_load(const char* name, void* data, size_t size)
+{
+    nvs_handle handle;
+    if(nvs_open(HIGH_SCORE_NVS_NAMESPACE, NVS_READONLY, &handle) != ESP_OK)
+        return false;
+
+    size_t length = size;
+    esp_err_t err = nvs_get_blob(handle, name, data, &length);
+    nvs_close(handle);
+    return err == ESP_OK && length == size;
+}
+
+// Stores the [size] bytes at [data] under [name], returns false if they could not be stored
+bool high_score_storage_save(const char* name, const void* data, size_t size)
+{
+    nvs_handle handle;
+    if(nvs_open(HIGH_SCORE_NVS_NAMESPACE, NVS_READWRITE, &handle) != ESP_OK)
+        return false;
+
+    // NVS writes the new blob before it erases the old one, a reset during the write keeps the last record
+    esp_err_t err = nvs_set_blob(handle, name, data, size);
+    if(err == ESP_OK)
+        err = nvs_commit(handle);
+    nvs_close(handle);
+    return err == ESP_OK;
+}
\ No newline at end of file
@@ -0,0 +1,94 @@
+/*
+    Author: Kenley Strik
+    Addition: This whole file was written by Kenley Strik
+*/
+
+#ifndef HIGH_SCORE_H
+#define HIGH_SCORE_H
+
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+#include "freertos/semphr.h"
+
+#include <stdint.h>
+#include <stdbool.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define HIGH_SCORE_TABLE_SIZE 8             // Ammount of scores kept in the table
+#define HIGH_SCORE_VERSION 1                // Version of the stored record, a record of another version is not loaded
+
+// Type for representing a score in the table
+typedef struct
+{
+    uint32_t score;                         // Ammount of openings the bird flew through during the round
+    uint32_t steps;                         // Ammount of steps the round lasted
+    uint32_t session;                       // Number of the session the round was played in, counted from 1
+} high_score_entry_t;
+
+// Type for representing the statistics of the rounds played during a session or during all sessions
+typedef struct
+{
+    uint32_t rounds;                        // Ammount of rounds played
+    uint32_t score_total;                   // Sum of the scores of the rounds
+    uint32_t best_score;                    // Highest score of the rounds
+    uint64_t steps;                         // Ammount of steps the rounds lasted together
+} high_score_stats_t;
+
+// Type for representing everything that is stored, the record is written as a whole
+typedef struct
+{
+    uint32_t version;                       // HIGH_SCORE_VERSION
+    uint32_t session_count;                 // Ammount of sessions started
+    uint32_t entry_count;                   // Ammount of scores in the table
+    high_score_entry_t entries[HIGH_SCORE_TABLE_SIZE];  // The highest scores from high to low, a score does not replace an equal one that was set earlier
+    high_score_stats_t session;             // Statistics of the current session, or of the last one until a new session is started
+    high_score_stats_t lifetime;            // Statistics of all sessions
+} high_score_record_t;
+
+/*
+    Type for representing a high score table that is kept in memory and stored with write-behind. Scores are
+    added to the record in memory right away, a background task writes the record some time after the last
+    change so the changes of many rounds are written together and the task adding the scores never waits on
+    the storage. Writing NVS turns off the flash cache of both cores and pauses every task running from flash,
+    so the task only writes while writes are allowed, the game allows them when it is idle. The record is stored
+    in NVS on the target and in a file on the host
+*/
+typedef struct
+{
+    const char* name;                       // Name the record is stored under, the NVS key on the target (at most 15 characters) and the file path on the host
+    high_score_record_t record;             // The record in memory, only used with the mutex taken
+    bool is_dirty;                          // Boolean value for indicating the record changed since it was last written
+    unsigned long change_count;             // Ammount of changes made to the record
+    unsigned long write_count;              // Ammount of times the record was written
+    unsigned long failed_write_count;       // Ammount of times writing the record failed, the record is written again with the next change
+
+    SemaphoreHandle_t mutex;                // Mutex guarding the record and the counters
+    TaskHandle_t task_handle;               // Task writing the record
+    SemaphoreHandle_t stopped_semaphore;    // Semaphore the task gives when it has stopped
+    bool is_stopping;                       // Boolean value for indicating the task has to write what is left and stop, only used with the mutex taken
+    bool is_write_allowed;                  // Boolean value for indicating the task may write the record, only used with the mutex taken
+    bool is_initialized;                    // Boolean value for indicating if the high score table is initialized
+} high_score_t;
+
+// Initializes the high score table given to the function with the record stored under [name] and starts the task writing it with priority [priority] pinned to core [core_id] (or tskNO_AFFINITY), returns false if the task could not be started
+bool high_score_init(high_score_t* scores, const char* name, UBaseType_t priority, BaseType_t core_id);
+// Writes the changes that were not written yet, stops the task and deinitializes the high score table given to the function
+void high_score_deinit(high_score_t* scores);
+
+// Starts a new session, the statistics of the session start from nothing, the new session is written with the next change
+void high_score_begin_session(high_score_t* scores);
+// Allows or forbids the task to write the record, a change made while writing is forbidden is written some time after writing is allowed again
+void high_score_allow_writes(high_score_t* scores, bool is_allowed);
+// Adds a round that ended with [score] after [steps] steps, returns its place in the table counted from 0 or -1 if it did not make the table, the record is written later
+int high_score_submit(high_score_t* scores, uint32_t score, uint32_t steps);
+// Stores a copy of the record in memory in [record], the changes that were not written yet are part of it
+void high_score_get_record(high_score_t* scores, high_score_record_t* record);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif  // HIGH_SCORE_H
\ No newline at end of file
@@ -0,0 +1,31 @@
+/*
+    Author: Kenley Strik
+    Addition: This whole file was written by Kenley Strik
+*/
+
+#ifndef HIGH_SCORE_STORAGE_H
+#define HIGH_SCORE_STORAGE_H
+
+#include <stdbool.h>
+#include <stddef.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*
+    Storage the high score record is kept in, high_score_nvs.c stores it in NVS on the target and
+    high_score_file.c of the host tools stores it in a file. Both are only called by the task writing the record
+    and by high_score_init, never by the task of the game
+*/
+
+// Reads the [size] bytes stored under [name] into [data], returns false if nothing of that size is stored
+bool high_score_storage_load(const char* name, void* data, size_t size);
+// Stores the [size] bytes at [data] under [name], returns false if they could not be stored
+bool high_score_storage_save(const char* name, const void* data, size_t size);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif  // HIGH_SCORE_STORAGE_H
\ No newline at end of file
@@ -5,18 +5,22 @@
 
 #include "include/i2c_driver.h"
 
-static SemaphoreHandle_t i2cSemaphore;     // Mutex for allowing only one task to read or write data across i2c bus
-static bool is_initialized = false;         // Boolean indicating if the I2CDriver is initialized
+static SemaphoreHandle_t i2cSemaphores[I2C_NUM_MAX];     // Mutexes for allowing only one task to read or write data across each i2c bus
+static bool is_initialized[I2C_NUM_MAX] = { false };       // Booleans indicating if the I2CDriver is initialized for each i2c bus
 
-// Initializes the i2c configuration
-i2c_result_t i2c_driver_init(i2c_mode_t mode, uint8_t sda_pin, uint8_t scl_pin, 
+// Initializes the i2c configuration of bus [port]
+i2c_result_t i2c_driver_init(i2c_port_t port, i2c_mode_t mode, uint8_t sda_pin, uint8_t scl_pin, 
             gpio_pullup_t sda_pullup_en, gpio_pullup_t scl_pullup_en, 
             unsigned int clk_speed)
 {
+    // Checks if the bus exists
+    if(port >= I2C_NUM_MAX)
+        return I2C_DRIVER_ERR_CONFIG;
+
     // Checks if i2c_driver is already initialized, and if not initialize it
-    if(!is_initialized)
+    if(!is_initialized[port])
     {
-        i2cSemaphore = xSemaphoreCreateMutex();	// Create mutex for reading and writing to and from i2c devices
+        i2cSemaphores[port] = xSemaphoreCreateMutex();	// Create mutex for reading and writing to and from i2c devices
 
         i2c_config_t config;
         config.mode = mode;
@@ -26,9 +30,9 @@ i2c_result_t i2c_driver_init(i2c_mode_t mode, uint8_t sda_pin, uint8_t scl_pin,
         config.scl_pullup_en = scl_pullup_en;
         config.master.clk_speed = clk_speed;
 
-        i2c_set_timeout(I2C_NUM_0, 20000);							// Set i2c timeout
+        i2c_set_timeout(port, 20000);							// Set i2c timeout
 
-        esp_err_t ret = i2c_param_config(I2C_NUM_0, &config);		// Set i2c configuration
+        esp_err_t ret = i2c_param_config(port, &config);		// Set i2c configuration
         if (ret != ESP_OK)
         {
             ESP_LOGE("I2CDriver", "PARAM CONFIG FAILED");
@@ -36,46 +40,72 @@ i2c_result_t i2c_driver_init(i2c_mode_t mode, uint8_t sda_pin, uint8_t scl_pin,
         }
         ESP_LOGV("I2CDriver", "PARAM CONFIG DONE");
 
-        ret = i2c_driver_install(I2C_NUM_0, config.mode, I2C_MASTER_TX_BUF_DISABLE, I2C_MASTER_RX_BUF_DISABLE, INTR_FLAGS);
+        ret = i2c_driver_install(port, config.mode, I2C_MASTER_TX_BUF_DISABLE, I2C_MASTER_RX_BUF_DISABLE, INTR_FLAGS);
         if (ret != ESP_OK) {
             ESP_LOGE("I2CDriver", "I2C DRIVER INSTALL FAILED");
             return I2C_DRIVER_ERR_INSTALL;
         }
         ESP_LOGV("I2CDriver", "I2C DRIVER INSTALLED");
 
-        is_initialized = true;
+        is_initialized[port] = true;
     }
     return I2C_DRIVER_OK;
 }
 
-// Deinitializes the i2c configuration
-i2c_result_t i2c_driver_deinit()
+// Deinitializes the i2c configuration of bus [port]
+i2c_result_t i2c_driver_deinit(i2c_port_t port)
 {
 	// Checks if i2c_driver is already initialized, and if it is deinitialize it
-    if(is_initialized)
+    if(port < I2C_NUM_MAX && is_initialized[port])
 	{
-		vSemaphoreDelete(i2cSemaphore);	// Destroy mutex for reading and write to and from i2c devices
-		is_initialized = false;
+		vSemaphoreDelete(i2cSemaphores[port]);	// Destroy mutex for reading and write to and from i2c devices
+		is_initialized[port] = false;
 	}
 	return I2C_DRIVER_OK;
 }
 
-// Write 8 bits to register [reg] at address [addr]
-i2c_result_t i2c_driver_write_register8(uint8_t addr, uint8_t reg, uint8_t data)
+// Write the single byte command [command] to address [addr] on bus [port]
+i2c_result_t i2c_driver_write_command(i2c_port_t port, uint8_t addr, uint8_t command)
+{
+	// Check if I2CDriver is already initialized, and if not write data
+	if(port < I2C_NUM_MAX && is_initialized[port])
+	{
+		xSemaphoreTake(i2cSemaphores[port], portMAX_DELAY);	// Enter critical section and take the semaphore to block other theads from entering
+		i2c_cmd_handle_t cmd = i2c_cmd_link_create();
+		i2c_master_start(cmd);
+		i2c_master_write_byte(cmd, (addr << 1) | WRITE_BIT, ACK_CHECK_EN);
+		i2c_master_write_byte(cmd, command, ACK_CHECK_EN);
+		i2c_master_stop(cmd);
+		esp_err_t ret = i2c_master_cmd_begin(port, cmd, 1000 / portTICK_RATE_MS);
+		i2c_cmd_link_delete(cmd);
+		xSemaphoreGive(i2cSemaphores[port]);					// Exit critical section and give the semaphore to unblock other theads from entering
+		if (ret != ESP_OK)
+		{
+			ESP_LOGE("I2CDriver", "ERROR: unable to write command %d", ret);
+			return I2C_DRIVER_ERR_FAIL;
+		}
+
+		return I2C_DRIVER_OK;
+	}
+	return I2C_DRIVER_ERR_NOT_INITIALIZED;
+}
+
+// Write 8 bits to register [reg] at address [addr] on bus [port]
+i2c_result_t i2c_driver_write_register8(i2c_port_t port, uint8_t addr, uint8_t reg, uint8_t data)
 {
     // Check if I2CDriver is already initialized, and if not write data
-	if(is_initialized)
+	if(port < I2C_NUM_MAX && is_initialized[port])
 	{
-		xSemaphoreTake(i2cSemaphore, portMAX_DELAY);	// Enter critical section and take the semaphore to block other theads from entering
+		xSemaphoreTake(i2cSemaphores[port], portMAX_DELAY);	// Enter critical section and take the semaphore to block other theads from entering
 		i2c_cmd_handle_t cmd = i2c_cmd_link_create();
 		i2c_master_start(cmd);
 		i2c_master_write_byte(cmd, (addr << 1) | WRITE_BIT, ACK_CHECK_EN);
 		i2c_master_write_byte(cmd, reg, ACK_CHECK_EN);
 		i2c_master_write_byte(cmd, data, ACK_CHECK_EN);
 		i2c_master_stop(cmd);
-		esp_err_t ret = i2c_master_cmd_begin(I2C_NUM_0, cmd, 1000 / portTICK_RATE_MS);
+		esp_err_t ret = i2c_master_cmd_begin(port, cmd, 1000 / portTICK_RATE_MS);
 		i2c_cmd_link_delete(cmd);
-		xSemaphoreGive(i2cSemaphore);					// Exit critical section and give the semaphore to unblock other theads from entering
+		xSemaphoreGive(i2cSemaphores[port]);					// Exit critical section and give the semaphore to unblock other theads from entering
 		if (ret != ESP_OK) {
 			ESP_LOGE("I2CDriver", "ERROR: unable to write to register %d", ret);
 			return I2C_DRIVER_ERR_FAIL;
@@ -86,13 +116,13 @@ i2c_result_t i2c_driver_write_register8(uint8_t addr, uint8_t reg, uint8_t data)
 	return I2C_DRIVER_ERR_NOT_INITIALIZED;
 }
 
-// Write 16 bits to register [reg] at address [addr] 
-i2c_result_t i2c_driver_write_register16(uint8_t addr, uint8_t reg, uint16_t data)
+// Write 16 bits to register [reg] at address [addr] on bus [port]
+i2c_result_t i2c_driver_write_register16(i2c_port_t port, uint8_t addr, uint8_t reg, uint16_t data)
 {
 	// Check if I2CDriver is already initialized, and if not write data
-	if(is_initialized)
+	if(port < I2C_NUM_MAX && is_initialized[port])
 	{
-		xSemaphoreTake(i2cSemaphore, portMAX_DELAY);	// Enter critical section and take the semaphore to block other theads from entering
+		xSemaphoreTake(i2cSemaphores[port], portMAX_DELAY);	// Enter critical section and take the semaphore to block other theads from entering
 		i2c_cmd_handle_t cmd = i2c_cmd_link_create();
 		i2c_master_start(cmd);
 		i2c_master_write_byte(cmd, (addr << 1) | WRITE_BIT, ACK_CHECK_EN);
@@ -100,9 +130,9 @@ i2c_result_t i2c_driver_write_register16(uint8_t addr, uint8_t reg, uint16_t dat
 		i2c_master_write_byte(cmd, data >> 8, ACK_CHECK_EN);
 		i2c_master_write_byte(cmd, data & 0xFF, ACK_CHECK_EN);
 		i2c_master_stop(cmd);
-		esp_err_t ret = i2c_master_cmd_begin(I2C_NUM_0, cmd, 1000 / portTICK_RATE_MS);
+		esp_err_t ret = i2c_master_cmd_begin(port, cmd, 1000 / portTICK_RATE_MS);
 		i2c_cmd_link_delete(cmd);
-		xSemaphoreGive(i2cSemaphore);					// Exit critical section and give the semaphore to unblock other theads from entering
+		xSemaphoreGive(i2cSemaphores[port]);					// Exit critical section and give the semaphore to unblock other theads from entering
 		if (ret != ESP_OK) {
 			ESP_LOGE("I2CDriver", "ERROR: unable to write to register %d", ret);
 			return I2C_DRIVER_ERR_FAIL;
@@ -113,13 +143,13 @@ i2c_result_t i2c_driver_write_register16(uint8_t addr, uint8_t reg, uint16_t dat
 	return I2C_DRIVER_ERR_NOT_INITIALIZED;
 }
 
-// Write 24 bits to register [reg] at address [addr] 
-i2c_result_t i2c_driver_write_register24(uint8_t addr, uint8_t reg, uint32_t data)
+// Write 24 bits to register [reg] at address [addr] on bus [port]
+i2c_result_t i2c_driver_write_register24(i2c_port_t port, uint8_t addr, uint8_t reg, uint32_t data)
 {
 	// Check if I2CDriver is already initialized, and if not write data
-	if(is_initialized)
+	if(port < I2C_NUM_MAX && is_initialized[port])
 	{
-		xSemaphoreTake(i2cSemaphore, portMAX_DELAY);	// Enter critical section and take the semaphore to block other theads from entering
+		xSemaphoreTake(i2cSemaphores[port], portMAX_DELAY);	// Enter critical section and take the semaphore to block other theads from entering
 		i2c_cmd_handle_t cmd = i2c_cmd_link_create();
 		i2c_master_start(cmd);
 		i2c_master_write_byte(cmd, (addr << 1) | WRITE_BIT, ACK_CHECK_EN);
@@ -128,9 +158,36 @@ i2c_result_t i2c_driver_write_register24(uint8_t addr, uint8_t reg, uint32_t dat
 		i2c_master_write_byte(cmd, data >> 8, ACK_CHECK_EN);
 		i2c_master_write_byte(cmd, data & 0xFF, ACK_CHECK_EN);
 		i2c_master_stop(cmd);
-		esp_err_t ret = i2c_master_cmd_begin(I2C_NUM_0, cmd, 1000 / portTICK_RATE_MS);
+		esp_err_t ret = i2c_master_cmd_begin(port, cmd, 1000 / portTICK_RATE_MS);
+		i2c_cmd_link_delete(cmd);
+		xSemaphoreGive(i2cSemaphores[port]);					// Exit critical section and give the semaphore to unblock other theads from entering
+		if (ret != ESP_OK)
+		{
+			ESP_LOGE("I2CDriver", "ERROR: unable to write to register %d", ret);
+			return I2C_DRIVER_ERR_FAIL;
+		}
+
+		return I2C_DRIVER_OK;
+	}
+	return I2C_DRIVER_ERR_NOT_INITIALIZED;
+}
+
+// Write [length] bytes starting at register [reg] at address [addr] on bus [port] in one transaction
+i2c_result_t i2c_driver_write_bytes(i2c_port_t port, uint8_t addr, uint8_t reg, const uint8_t* data, size_t length)
+{
+	// Check if I2CDriver is already initialized, and if not write data
+	if(port < I2C_NUM_MAX && is_initialized[port])
+	{
+		xSemaphoreTake(i2cSemaphores[port], portMAX_DELAY);	// Enter critical section and take the semaphore to block other theads from entering
+		i2c_cmd_handle_t cmd = i2c_cmd_link_create();
+		i2c_master_start(cmd);
+		i2c_master_write_byte(cmd, (addr << 1) | WRITE_BIT, ACK_CHECK_EN);
+		i2c_master_write_byte(cmd, reg, ACK_CHECK_EN);		// Devices that auto increment their address store the bytes in the registers after [reg]
+		i2c_master_write(cmd, (uint8_t*)data, length, ACK_CHECK_EN);
+		i2c_master_stop(cmd);
+		esp_err_t ret = i2c_master_cmd_begin(port, cmd, 1000 / portTICK_RATE_MS);
 		i2c_cmd_link_delete(cmd);
-		xSemaphoreGive(i2cSemaphore);					// Exit critical section and give the semaphore to unblock other theads from entering
+		xSemaphoreGive(i2cSemaphores[port]);					// Exit critical section and give the semaphore to unblock other theads from entering
 		if (ret != ESP_OK)
 		{
 			ESP_LOGE("I2CDriver", "ERROR: unable to write to register %d", ret);
@@ -142,22 +199,51 @@ i2c_result_t i2c_driver_write_register24(uint8_t addr, uint8_t reg, uint32_t dat
 	return I2C_DRIVER_ERR_NOT_INITIALIZED;
 }
 
-// Read 8 bits from register [reg] at address [addr]
-i2c_result_t i2c_driver_read_register8(uint8_t addr, uint8_t reg, uint8_t* data)
+// Read [length] bytes starting at register [reg] at address [addr] on bus [port] in one transaction with a repeated start
+i2c_result_t i2c_driver_read_bytes(i2c_port_t port, uint8_t addr, uint8_t reg, uint8_t* data, size_t length)
+{
+	// Check if I2CDriver is already initialized, and if not read data
+	if(port < I2C_NUM_MAX && is_initialized[port] && length > 0)
+	{
+		xSemaphoreTake(i2cSemaphores[port], portMAX_DELAY);	// Enter critical section and take the semaphore to block other theads from entering
+		i2c_cmd_handle_t cmd = i2c_cmd_link_create();
+		i2c_master_start(cmd);
+		i2c_master_write_byte(cmd, (addr << 1) | WRITE_BIT, ACK_CHECK_EN);
+		i2c_master_write_byte(cmd, reg, ACK_CHECK_EN);
+		i2c_master_start(cmd);									// Repeated start, the device keeps the register pointer for the read
+		i2c_master_write_byte(cmd, (addr << 1) | READ_BIT, ACK_CHECK_EN);
+		i2c_master_read(cmd, data, length, I2C_MASTER_LAST_NACK);
+		i2c_master_stop(cmd);
+		esp_err_t ret = i2c_master_cmd_begin(port, cmd, 1000 / portTICK_RATE_MS);
+		i2c_cmd_link_delete(cmd);
+		xSemaphoreGive(i2cSemaphores[port]);					// Exit critical section and give the semaphore to unblock other theads from entering
+		if (ret != ESP_OK)
+		{
+			ESP_LOGE("I2CDriver", "ERROR: unable to read reg %02x from address %02x %d", reg, addr, ret);
+			return I2C_DRIVER_ERR_FAIL;
+		}
+
+		return I2C_DRIVER_OK;
+	}
+	return I2C_DRIVER_ERR_NOT_INITIALIZED;
+}
+
+// Read 8 bits from register [reg] at address [addr] on bus [port]
+i2c_result_t i2c_driver_read_register8(i2c_port_t port, uint8_t addr, uint8_t reg, uint8_t* data)
 {
 	// Check if I2CDriver is already initialized, and if not read data
-	if(is_initialized)
+	if(port < I2C_NUM_MAX && is_initialized[port])
 	{
-		xSemaphoreTake(i2cSemaphore, portMAX_DELAY);	// Enter critical section and take the semaphore to block other theads from entering
+		xSemaphoreTake(i2cSemaphores[port], portMAX_DELAY);	// Enter critical section and take the semaphore to block other theads from entering
 		i2c_cmd_handle_t cmd = i2c_cmd_link_create();
 		i2c_master_start(cmd);
 		i2c_master_write_byte(cmd, (addr << 1) | WRITE_BIT, ACK_CHECK_EN);
 		i2c_master_write_byte(cmd, reg, ACK_CHECK_EN);
 		i2c_master_stop(cmd);
-		esp_err_t ret = i2c_master_cmd_begin(I2C_NUM_0, cmd, 1000 / portTICK_RATE_MS);
+		esp_err_t ret = i2c_master_cmd_begin(port, cmd, 1000 / portTICK_RATE_MS);
 		i2c_cmd_link_delete(cmd);
 		if (ret != ESP_OK) {
-			xSemaphoreGive(i2cSemaphore);				// Exit critical section and give the semaphore to unblock other theads from entering
+			xSemaphoreGive(i2cSemaphores[port]);				// Exit critical section and give the semaphore to unblock other theads from entering
 			ESP_LOGE("I2CDriver", "ERROR: unable to write address %02x to read reg %02x %d", addr, reg, ret);
 			return I2C_DRIVER_ERR_FAIL;
 		}
@@ -168,9 +254,9 @@ i2c_result_t i2c_driver_read_register8(uint8_t addr, uint8_t reg, uint8_t* data)
 		i2c_master_start(cmd);
 		i2c_master_write_byte(cmd, (addr << 1) | READ_BIT, ACK_CHECK_EN);
 		i2c_master_read_byte(cmd, data, (i2c_ack_type_t)ACK_VAL);
-		ret = i2c_master_cmd_begin(I2C_NUM_0, cmd, 1000 / portTICK_RATE_MS);
+		ret = i2c_master_cmd_begin(port, cmd, 1000 / portTICK_RATE_MS);
 		i2c_cmd_link_delete(cmd);
-		xSemaphoreGive(i2cSemaphore);					// Exit critical section and give the semaphore to unblock other theads from entering
+		xSemaphoreGive(i2cSemaphores[port]);					// Exit critical section and give the semaphore to unblock other theads from entering
 		if (ret != ESP_OK)
 		{
 			ESP_LOGE("I2CDriver", "ERROR: unable to write address %02x to read reg %02x %d", addr, reg, ret);
@@ -182,23 +268,23 @@ i2c_result_t i2c_driver_read_register8(uint8_t addr, uint8_t reg, uint8_t* data)
 	return I2C_DRIVER_ERR_NOT_INITIALIZED;
 }
 
-// Read 16 bits from register [reg] at address [addr]
-i2c_result_t i2c_driver_read_register16(uint8_t addr, uint8_t reg, uint16_t* data)
+// Read 16 bits from register [reg] at address [addr] on bus [port]
+i2c_result_t i2c_driver_read_register16(i2c_port_t port, uint8_t addr, uint8_t reg, uint16_t* data)
 {
 	// Check if I2CDriver is already initialized, and if not read data
-	if(is_initialized)
+	if(port < I2C_NUM_MAX && is_initialized[port])
 	{
-		xSemaphoreTake(i2cSemaphore, portMAX_DELAY);	// Enter critical section and take the semaphore to block other theads from entering
+		xSemaphoreTake(i2cSemaphores[port], portMAX_DELAY);	// Enter critical section and take the semaphore to block other theads from entering
 		i2c_cmd_handle_t cmd = i2c_cmd_link_create();
 		i2c_master_start(cmd);
 		i2c_master_write_byte(cmd, (addr << 1) | WRITE_BIT, ACK_CHECK_EN);
 		i2c_master_write_byte(cmd, reg, ACK_CHECK_EN);
 		i2c_master_stop(cmd);
-		esp_err_t ret = i2c_master_cmd_begin(I2C_NUM_0, cmd, 1000 / portTICK_RATE_MS);
+		esp_err_t ret = i2c_master_cmd_begin(port, cmd, 1000 / portTICK_RATE_MS);
 		i2c_cmd_link_delete(cmd);
 		if (ret != ESP_OK)
 		{
-			xSemaphoreGive(i2cSemaphore);				// Exit critical section and give the semaphore to unblock other theads from entering
+			xSemaphoreGive(i2cSemaphores[port]);				// Exit critical section and give the semaphore to unblock other theads from entering
 			ESP_LOGE("I2CDriver", "ERROR: unable to write address %02x to read reg %02x %d", addr, reg, ret);
 			return I2C_DRIVER_ERR_FAIL;
 		}
@@ -213,9 +299,9 @@ i2c_result_t i2c_driver_read_register16(uint8_t addr, uint8_t reg, uint16_t* dat
 		i2c_master_write_byte(cmd, (addr << 1) | READ_BIT, ACK_CHECK_EN);
 		i2c_master_read_byte(cmd, &lsb, (i2c_ack_type_t)ACK_VAL);
 		i2c_master_read_byte(cmd, &msb, (i2c_ack_type_t)ACK_VAL);
-		ret = i2c_master_cmd_begin(I2C_NUM_0, cmd, 1000 / portTICK_RATE_MS);
+		ret = i2c_master_cmd_begin(port, cmd, 1000 / portTICK_RATE_MS);
 		i2c_cmd_link_delete(cmd);
-		xSemaphoreGive(i2cSemaphore);					// Exit critical section and give the semaphore to unblock other theads from entering
+		xSemaphoreGive(i2cSemaphores[port]);					// Exit critical section and give the semaphore to unblock other theads from entering
 		if (ret != ESP_OK)
 		{
 			ESP_LOGE("I2CDriver", "ERROR: unable to write address %02x to read reg %02x %d", addr, reg, ret);
@@ -40,24 +40,30 @@ static const size_t I2C_MASTER_TX_BUF_DISABLE = 0;
 static const size_t I2C_MASTER_RX_BUF_DISABLE = 0;
 static const int INTR_FLAGS = 0;
 
-// Initializes the i2c configuration
-i2c_result_t i2c_driver_init(i2c_mode_t mode, uint8_t sda_pin, uint8_t scl_pin, 
+// Initializes the i2c configuration of bus [port]
+i2c_result_t i2c_driver_init(i2c_port_t port, i2c_mode_t mode, uint8_t sda_pin, uint8_t scl_pin, 
             gpio_pullup_t sda_pullup_en, gpio_pullup_t scl_pullup_en, 
             unsigned int clk_speed);
-// Deinitializes the i2c configuration
-i2c_result_t i2c_driver_deinit();
+// Deinitializes the i2c configuration of bus [port]
+i2c_result_t i2c_driver_deinit(i2c_port_t port);
 
-// Write 8 bits to register [reg] at address [addr]
-i2c_result_t i2c_driver_write_register8(uint8_t addr, uint8_t reg, uint8_t data);
-// Write 16 bits to register [reg] at address [addr] 
-i2c_result_t i2c_driver_write_register16(uint8_t addr, uint8_t reg, uint16_t data);
-// Write 24 bits to register [reg] at address [addr] 
-i2c_result_t i2c_driver_write_register24(uint8_t addr, uint8_t reg, uint32_t data);
+// Write the single byte command [command] to address [addr] on bus [port]
+i2c_result_t i2c_driver_write_command(i2c_port_t port, uint8_t addr, uint8_t command);
+// Write 8 bits to register [reg] at address [addr] on bus [port]
+i2c_result_t i2c_driver_write_register8(i2c_port_t port, uint8_t addr, uint8_t reg, uint8_t data);
+// Write 16 bits to register [reg] at address [addr] on bus [port]
+i2c_result_t i2c_driver_write_register16(i2c_port_t port, uint8_t addr, uint8_t reg, uint16_t data);
+// Write 24 bits to register [reg] at address [addr] on bus [port]
+i2c_result_t i2c_driver_write_register24(i2c_port_t port, uint8_t addr, uint8_t reg, uint32_t data);
+// Write [length] bytes starting at register [reg] at address [addr] on bus [port] in one transaction
+i2c_result_t i2c_driver_write_bytes(i2c_port_t port, uint8_t addr, uint8_t reg, const uint8_t* data, size_t length);
 
-// Read 8 bits from register [reg] at address [addr]
-i2c_result_t i2c_driver_read_register8(uint8_t addr, uint8_t reg, uint8_t* data);
-// Read 16 bits from register [reg] at address [addr]
-i2c_result_t i2c_driver_read_register16(uint8_t addr, uint8_t reg, uint16_t* data);
+// Read [length] bytes starting at register [reg] at address [addr] on bus [port] in one transaction with a repeated start
+i2c_result_t i2c_driver_read_bytes(i2c_port_t port, uint8_t addr, uint8_t reg, uint8_t* data, size_t length);
+// Read 8 bits from register [reg] at address [addr] on bus [port]
+i2c_result_t i2c_driver_read_register8(i2c_port_t port, uint8_t addr, uint8_t reg, uint8_t* data);
+// Read 16 bits from register [reg] at address [addr] on bus [port]
+i2c_result_t i2c_driver_read_register16(i2c_port_t port, uint8_t addr, uint8_t reg, uint16_t* data);
 
 #ifdef __cplusplus
 }
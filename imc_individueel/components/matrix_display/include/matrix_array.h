@@ -10,7 +10,13 @@
 #include <stdbool.h>
 #include <stdlib.h>
 
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+#include "freertos/event_groups.h"
+#include "esp_timer.h"
+
 #include "matrix_display.h"
+#include "matrix_bitmap.h"
 
 #ifdef __cplusplus
 extern "C" {
@@ -23,13 +29,96 @@ typedef enum
     VERTICAL
 } display_orientation_t;
 
-// Type for representing the matrix array
+#define MATRIX_ARRAY_MAX_LAYERS 4          // Maximum ammount of layers a matrix array can compose its framebuffer of
+#define MATRIX_ARRAY_FRAMEBUFFER -1        // Layer index for drawing on the framebuffer directly instead of on a layer
+#define MATRIX_ARRAY_CANVAS -2             // Layer index for drawing on the virtual canvas of the matrix array
+
+// Enumerator for the different ways a layer is combined with the layers below it
+typedef enum
+{
+    LAYER_BLEND_OR,                         // Pixels turned on in the layer are turned on
+    LAYER_BLEND_AND_NOT,                    // Pixels turned on in the layer are turned off (mask)
+    LAYER_BLEND_XOR                         // Pixels turned on in the layer are inverted
+} layer_blend_t;
+
+// Type for representing a layer of the matrix array that is composed into the framebuffer on the next update
 typedef struct
+{
+    matrix_bitmap_t bitmap;                 // Pixels of the layer, the same size as the framebuffer
+    layer_blend_t blend;                    // The way the layer is combined with the layers below it
+    bool is_visible;                        // Boolean value for indicating if the layer is part of the composition
+    bool has_changed;                       // Boolean value for indicating if the layer was drawn on since the last composition
+} matrix_array_layer_t;
+
+// Type for representing a rectangular region of the matrix array
+typedef struct
+{
+    int x, y;                               // Position of the top left pixel of the region
+    int width, height;                      // Size of the region in pixels, a region with a width or height of 0 is empty
+} matrix_array_region_t;
+
+// Type for representing the I2C bus and address of a matrix display that is added to a matrix array
+typedef struct
+{
+    i2c_port_t i2c_port;                    // I2C bus the matrix display is connected to
+    uint8_t i2c_address;                    // I2C address of the matrix display
+} matrix_array_display_address_t;
+
+struct matrix_array;
+
+// Type for representing a worker task that updates all the matrix displays connected to one I2C bus
+typedef struct
+{
+    struct matrix_array* array;             // Matrix array the worker task belongs to
+    i2c_port_t i2c_port;                    // I2C bus the worker task updates the matrix displays of
+    TaskHandle_t task_handle;               // Handle of the worker task, NULL when the bus is updated by the task calling matrix_array_update
+    bool is_stopping;                       // Boolean value for indicating the worker task has to stop
+    int64_t last_flush_time;                // Time in microseconds it took to update the matrix displays on the bus during the last update
+} matrix_array_bus_worker_t;
+
+// Type for representing the matrix array
+typedef struct matrix_array
 {
     display_orientation_t orientation;      // Orientation of the matrix array
+    matrix_bitmap_t framebuffer;            // Framebuffer for the whole surface of the matrix array, the matrix displays are views on its rows
     matrix_display_t* matrix_displays;      // Pointer pointing to the fisrt matrix display in the matrix array
     unsigned int matrix_display_count;      // Ammount of matrix display's that are part of the matrix array
     bool is_initialized;                    // Boolean value for indicating if the matrix array is initialized
+
+    uint32_t* dirty_displays;               // Bit i is set when matrix display i was drawn on since the last update
+    uint32_t* lit_displays;                 // Bit i is set when matrix display i had pixels turned on after the last update
+    matrix_array_region_t dirty_region;     // Bounding box of everything that was drawn since the last update
+
+    uint8_t* batch_set_masks;               // Pixels to turn on for every framebuffer byte while a batch of pixels is set, all zero otherwise
+    uint8_t* batch_clear_masks;             // Pixels to turn off for every framebuffer byte while a batch of pixels is set, all zero otherwise
+    unsigned int* batch_touched_bytes;      // Indices of the framebuffer bytes touched by a batch of pixels
+    unsigned int batch_size;                // Ammount of bytes the batch buffers have room for, enough for the largest bitmap that can be drawn on
+
+    matrix_array_layer_t layers[MATRIX_ARRAY_MAX_LAYERS];  // Layers the framebuffer is composed of from bottom to top
+    unsigned int layer_count;               // Ammount of layers of the matrix array, without layers the framebuffer is drawn on directly
+    int draw_layer;                         // Index of the layer the drawing and read-back functions use, or MATRIX_ARRAY_FRAMEBUFFER or MATRIX_ARRAY_CANVAS
+
+    matrix_bitmap_t canvas;                 // Virtual canvas that can be larger than the matrix array, the viewport of it is shown
+    int canvas_layer;                       // Index of the layer (or MATRIX_ARRAY_FRAMEBUFFER) the viewport of the canvas is shown on
+    int viewport_x;                         // Position on the canvas of the top left pixel of the matrix array
+    int viewport_y;
+    matrix_array_region_t canvas_region;    // Region of the canvas that was drawn on or exposed since the last update
+
+    matrix_array_bus_worker_t bus_workers[I2C_NUM_MAX];     // Worker task for every I2C bus
+    EventGroupHandle_t flush_events;        // Event group the update uses to start the worker tasks and the worker tasks use to report they are done
+    int64_t last_flush_time;                // Time in microseconds it took to update all the matrix displays during the last update
+    int64_t setup_time;                     // Time in microseconds it took to add and set up the matrix displays the last time matrix displays were added
+    int64_t first_frame_time;               // Time in microseconds since boot at which the first update reached the matrix displays, 0 before that
+    bool is_grayscale;                      // Boolean value for indicating if a grayscale task refreshes the matrix displays instead of matrix_array_update
+
+    TaskHandle_t health_task_handle;        // Handle of the task that checks the health of the matrix displays, NULL when they are not checked
+    unsigned int health_check_period;       // Time in milliseconds between two checks of all the matrix displays
+    BaseType_t health_check_core;           // Core the health task is pinned to
+    volatile bool is_health_stopping;       // Boolean value for indicating the health task has to stop
+    volatile bool has_recovered_displays;   // Boolean value for indicating the health task set up matrix displays again whose rows have to be sent
+
+    esp_timer_handle_t fade_timer;          // Timer that moves the brightness of the matrix displays one level closer to the fade target at every step
+    uint8_t fade_target;                    // Brightness level the matrix displays are faded to
 } matrix_array_t;
 
 // Initializes the matrix array given to the function
@@ -37,17 +126,80 @@ void matrix_array_init(matrix_array_t** array, display_orientation_t orientation
 // Deinitializes the matrix array given to the function
 void matrix_array_deinit(matrix_array_t** array);
 
-// Adds a matrix display to the array
-void matrix_array_add_matrix_display(matrix_array_t** array, uint8_t i2c_address);
+// Adds a matrix display connected to I2C bus [i2c_port] to the array, returns false if there was not enough memory
+bool matrix_array_add_matrix_display(matrix_array_t** array, i2c_port_t i2c_port, uint8_t i2c_address);
+// Adds [count] matrix displays to the array at once, the buffers grow only once and the matrix displays of every I2C bus are set up in parallel, returns false if there was not enough memory and leaves the array as it was
+bool matrix_array_add_matrix_displays(matrix_array_t** array, const matrix_array_display_address_t* addresses, unsigned int count);
+// Starts a worker task pinned to core [core_id] (or tskNO_AFFINITY) that updates the matrix displays on I2C bus [i2c_port] in parallel with the other buses
+void matrix_array_start_bus_worker(matrix_array_t** array, i2c_port_t i2c_port, BaseType_t core_id);
+// Stops the worker tasks of all I2C buses, after which the matrix displays are updated by the task calling matrix_array_update
+void matrix_array_stop_bus_workers(matrix_array_t** array);
+// Starts a health task pinned to core [core_id] (or tskNO_AFFINITY) that checks every matrix display once every [period] milliseconds and sets up the ones that were lost again
+void matrix_array_start_health_check(matrix_array_t** array, unsigned int period, BaseType_t core_id);
+// Stops the health task, the matrix displays are no longer checked
+void matrix_array_stop_health_check(matrix_array_t** array);
+// Adds a layer on top of the other layers that is combined with them using [blend], returns the index of the layer or -1 if there is no room
+int matrix_array_add_layer(matrix_array_t** array, layer_blend_t blend);
+// Selects the layer (or MATRIX_ARRAY_FRAMEBUFFER) the drawing and read-back functions use
+void matrix_array_select_layer(matrix_array_t** array, int layer);
+// Shows or hides a layer in the composition
+void matrix_array_set_layer_visible(matrix_array_t** array, int layer, bool is_visible);
+// Combines the visible layers into the framebuffer in one pass and marks the pixels that changed, the update does this when a layer has changed
+void matrix_array_compose(matrix_array_t** array);
+
+// Attaches a cleared virtual canvas of [width] x [height] pixels whose viewport is shown on [layer] (or MATRIX_ARRAY_FRAMEBUFFER), returns false if there was not enough memory
+bool matrix_array_attach_canvas(matrix_array_t** array, unsigned int width, unsigned int height, int layer);
+// Moves the viewport to [x, y] on the canvas, the shown pixels are shifted and only the newly exposed rows and columns are copied from the canvas
+void matrix_array_set_viewport(matrix_array_t** array, int x, int y);
+// Moves all the pixels of the canvas [dx] pixels to the right and [dy] pixels down, the shifted in rows and columns are cleared for drawing
+void matrix_array_scroll_canvas(matrix_array_t** array, int dx, int dy);
+
 // Sets the value (on/off : 1/0) of a pixel on the corresponding matrix display on the array at a certain x and y position
 void matrix_array_set_pixel(matrix_array_t** array, int x, int y, bool is_on);
 // Sets the values (on/off : 1/0) of multiple pixels on the corresponding matrix display on the array
 void matrix_array_set_pixels(matrix_array_t** array, matrix_display_value_pair_t* pixel_values, unsigned int length);
-// Updates the matrix displays with the data in the buffers
+// Sets the values (on/off : 1/0) of [length] pixels in a horizontal line starting at a certain x and y position
+void matrix_array_draw_hline(matrix_array_t** array, int x, int y, int length, bool is_on);
+// Sets the values (on/off : 1/0) of [length] pixels in a vertical line starting at a certain x and y position
+void matrix_array_draw_vline(matrix_array_t** array, int x, int y, int length, bool is_on);
+// Sets the values (on/off : 1/0) of all the pixels in a rectangle of [width] x [height] pixels at a certain x and y position
+void matrix_array_fill_rect(matrix_array_t** array, int x, int y, int width, int height, bool is_on);
+// Sets [width] (at most 32) pixels of row [y] starting at [x] to the bits of [bits] where bit n is the pixel at x + n
+void matrix_array_set_row_bits(matrix_array_t** array, int x, int y, int width, uint32_t bits);
+// Moves the pixels of [height] rows starting at row [y] [dx] pixels to the right, the pixels that are shifted in are (off : 0)
+void matrix_array_shift_rows(matrix_array_t** array, int y, int height, int dx);
+// Returns the value (on/off : 1/0) of a pixel on the array at a certain x and y position, pixels outside the array are off
+bool matrix_array_get_pixel(matrix_array_t** array, int x, int y);
+// Returns [width] (at most 32) pixels of row [y] starting at [x] packed in a mask where bit n is the pixel at x + n
+uint32_t matrix_array_get_row_bits(matrix_array_t** array, int x, int y, int width);
+// Stores the pixels of the rectangle at [x, y] of [width] (at most 32) x [height] pixels as one packed mask per row in [rows]
+void matrix_array_get_region(matrix_array_t** array, int x, int y, int width, int height, uint32_t* rows);
+// Checks if any pixel in the packed masks of [mask_rows] (one per row, [width] at most 32) placed at [x, y] is turned on on the array
+bool matrix_array_test_mask(matrix_array_t** array, int x, int y, const uint32_t* mask_rows, int width, int height);
+// Returns the bitmap of the selected layer (or framebuffer or canvas) to draw on with the matrix_bitmap functions, the drawn pixels are marked with matrix_array_mark_region_drawn
+matrix_bitmap_t* matrix_array_get_selected_bitmap(matrix_array_t** array);
+// Marks the rectangle at [x, y] of [width] x [height] pixels of the selected layer (or framebuffer or canvas) as drawn on, so the next update shows it
+void matrix_array_mark_region_drawn(matrix_array_t** array, int x, int y, int width, int height);
+// Copies the drawn pixels of the canvas inside the viewport, composes changed layers and updates the matrix displays with the data in the buffers, every I2C bus with a worker task is updated in parallel
 void matrix_array_update(matrix_array_t** array);
-// Sets the values of all the pixels of the matrix displays to (off : 0) essentially clearing the matrix displays
+// Updates the dirty matrix displays with the rows they are bound to without composing the layers, every I2C bus with a worker task is updated in parallel
+void matrix_array_flush(matrix_array_t** array);
+// Points the rows of every matrix display to the part of [bitmap] (the size of the framebuffer) that is shown on it and marks them to be checked on the next flush
+void matrix_array_bind_displays(matrix_array_t** array, matrix_bitmap_t* bitmap);
+// Sets the values of all the pixels of the selected layer or framebuffer to (off : 0), the matrix displays are cleared on the next update
 void matrix_array_clear(matrix_array_t** array);
 
+// Sets the brightness level (0 to MATRIX_DISPLAY_MAX_BRIGHTNESS) of all the matrix displays and stops a running fade
+void matrix_array_set_brightness(matrix_array_t** array, uint8_t brightness);
+// Changes the brightness of all the matrix displays to [brightness] in [duration] milliseconds, one brightness command per matrix display and level is written
+void matrix_array_fade_brightness(matrix_array_t** array, uint8_t brightness, unsigned int duration);
+// Sets the blink rate of all the matrix displays
+void matrix_array_set_blink(matrix_array_t** array, matrix_display_blink_t blink);
+// Turns the LEDs of all the matrix displays on or off without changing the display RAM
+void matrix_array_set_display_on(matrix_array_t** array, bool is_on);
+// Stops (standby) or starts the oscillator of all the matrix displays, the display RAM is kept during standby
+void matrix_array_set_standby(matrix_array_t** array, bool is_standby);
+
 #ifdef __cplusplus
 }
 #endif
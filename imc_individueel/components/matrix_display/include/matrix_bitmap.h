@@ -0,0 +1,69 @@
+/*
+    Author: Kenley Strik
+    Addition: This whole file was written by Kenley Strik
+*/
+
+#ifndef MATRIX_BITMAP_H
+#define MATRIX_BITMAP_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stdlib.h>
+#include <string.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*
+    Type for representing a packed 1-bit bitmap, the pixels are stored row after row with [stride] bytes per row
+    and the pixel at x is stored in bit (x % 8) of byte (x / 8) of its row, the data is padded to whole 32-bit words
+    so bitmaps of the same size can be combined one word at a time
+*/
+typedef struct
+{
+    uint8_t* data;              // Pointer to the first byte of the first row of the bitmap
+    unsigned int width;         // Width of the bitmap in pixels
+    unsigned int height;        // Height of the bitmap in pixels
+    unsigned int stride;        // Number of bytes between the start of two rows
+} matrix_bitmap_t;
+
+// Allocates a cleared bitmap of [width] x [height] pixels, returns false if there was not enough memory
+bool matrix_bitmap_init(matrix_bitmap_t* bitmap, unsigned int width, unsigned int height);
+// Releases the memory of the bitmap
+void matrix_bitmap_deinit(matrix_bitmap_t* bitmap);
+// Returns the number of 32-bit words the data of the bitmap is made of
+unsigned int matrix_bitmap_get_word_count(const matrix_bitmap_t* bitmap);
+
+// Sets the value (on/off : 1/0) of the pixel at a certain x and y position, positions outside the bitmap are ignored
+void matrix_bitmap_set_pixel(matrix_bitmap_t* bitmap, int x, int y, bool is_on);
+// Returns the value (on/off : 1/0) of the pixel at a certain x and y position, positions outside the bitmap are off
+bool matrix_bitmap_get_pixel(const matrix_bitmap_t* bitmap, int x, int y);
+// Returns [width] (at most 32) pixels of row [y] starting at [x] packed in a mask where bit n is the pixel at x + n, pixels outside the bitmap are off
+uint32_t matrix_bitmap_get_bits(const matrix_bitmap_t* bitmap, int x, int y, int width);
+// Sets [width] (at most 32) pixels of row [y] starting at [x] to the bits of [bits] where bit n is the pixel at x + n, pixels outside the bitmap are ignored
+void matrix_bitmap_set_bits(matrix_bitmap_t* bitmap, int x, int y, int width, uint32_t bits);
+// Stores the pixels of the rectangle at [x, y] of [width] (at most 32) x [height] pixels as one packed mask per row in [rows]
+void matrix_bitmap_get_region(const matrix_bitmap_t* bitmap, int x, int y, int width, int height, uint32_t* rows);
+// Checks if any pixel in the packed masks of [mask_rows] (one per row, [width] at most 32) placed at [x, y] is turned on in the bitmap
+bool matrix_bitmap_test_mask(const matrix_bitmap_t* bitmap, int x, int y, const uint32_t* mask_rows, int width, int height);
+// Sets the value of [length] pixels on row [y] starting at [x], the span is clipped to the bitmap
+void matrix_bitmap_fill_span(matrix_bitmap_t* bitmap, int x, int y, int length, bool is_on);
+// Sets the value of all the pixels in the rectangle at [x, y] of [width] x [height] pixels, the rectangle is clipped to the bitmap
+void matrix_bitmap_fill_rect(matrix_bitmap_t* bitmap, int x, int y, int width, int height, bool is_on);
+// Sets the value of [length] pixels in column [x] starting at row [y], the line is clipped to the bitmap
+void matrix_bitmap_draw_vline(matrix_bitmap_t* bitmap, int x, int y, int length, bool is_on);
+// Copies the rectangle at [source_x, source_y] of [width] x [height] pixels of [source] to [x, y] of the bitmap, 32 pixels at a time
+void matrix_bitmap_copy_rect(matrix_bitmap_t* bitmap, int x, int y, const matrix_bitmap_t* source, int source_x, int source_y, int width, int height);
+// Moves all the pixels of the bitmap [dx] pixels to the right and [dy] pixels down, the pixels that are shifted in are (off : 0)
+void matrix_bitmap_shift(matrix_bitmap_t* bitmap, int dx, int dy);
+// Moves the pixels of [height] rows starting at row [y] [dx] pixels to the right, the pixels that are shifted in are (off : 0)
+void matrix_bitmap_shift_rows(matrix_bitmap_t* bitmap, int y, int height, int dx);
+// Sets the values of all the pixels of the bitmap to (off : 0)
+void matrix_bitmap_clear(matrix_bitmap_t* bitmap);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif  // MATRIX_BITMAP_H
\ No newline at end of file
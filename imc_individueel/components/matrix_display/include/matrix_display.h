@@ -16,6 +16,18 @@
 extern "C" {
 #endif
 
+#define MATRIX_DISPLAY_MAX_BRIGHTNESS 15     // Highest brightness level of a matrix display, the levels go from 0 (1/16 duty) to 15 (16/16 duty)
+#define MATRIX_DISPLAY_DEFAULT_BRIGHTNESS 7  // Brightness level a matrix display is initialized with
+
+// Enumerator for the blink rates of a matrix display
+typedef enum
+{
+    MATRIX_DISPLAY_BLINK_OFF,
+    MATRIX_DISPLAY_BLINK_2HZ,
+    MATRIX_DISPLAY_BLINK_1HZ,
+    MATRIX_DISPLAY_BLINK_HALF_HZ
+} matrix_display_blink_t;
+
 // Type for representing the position data and state of a LED for the matrix display
 typedef struct
 {
@@ -24,19 +36,26 @@ typedef struct
     bool is_on;                 // Boolean value indicating if the LED at [x, y] is on or off
 } matrix_display_value_pair_t;
 
-// Type for representing the value of a row on the matrix display and if it has changed after the last update
-typedef struct
-{
-    uint8_t data;               // Value of matrix display row
-    bool has_changed;           // Boolean value for indicating if the row data has changed
-} row_pair_t;
-
-// Type for representing the matrix display with its I2C address and buffer of row data
+/*
+    Type for representing the matrix display with its I2C bus, I2C address and a view on its 8 rows of pixel data,
+    the rows are either owned by the display or are part of the framebuffer of a matrix array
+*/
 typedef struct
 {
+    i2c_port_t i2c_port;        // I2C bus the matrix display is connected to
     uint8_t i2c_address;        // I2C address of the matrix display
-    row_pair_t* buffer;         // Buffer for row values of the display and booleans for indicating change in data on a row
-    unsigned int buffer_length; // Length of buffer indicating the number of elements
+    uint8_t* rows;              // Pointer to the first row of the display, the pixel at x is bit x of a row (NULL lets the display allocate its own rows)
+    unsigned int row_stride;    // Number of bytes between two rows of the display
+    uint8_t sent_rows[8];       // Row values as they were last written to the display in the order of the display RAM
+    uint8_t dirty_rows;         // Bit y is set when row y was drawn on since the last update, only those rows are checked by the update
+    bool owns_rows;             // Boolean value for indicating if the rows were allocated by the display
+    uint8_t brightness;         // Brightness level as it was last written to the display
+    matrix_display_blink_t blink;   // Blink rate as it was last written to the display
+    bool is_display_on;         // Boolean value indicating if the display was last turned on or off
+    bool is_standby;            // Boolean value indicating if the oscillator of the display was last stopped (standby)
+    volatile bool is_lost;      // Boolean value indicating if the display did not respond or lost its setup, it is skipped by the update until it is set up again
+    volatile bool is_recovered; // Boolean value indicating if the display was set up again and all its rows have to be sent again
+    unsigned int recovery_count;    // Ammount of times the display was set up again after it was lost
     bool is_initialized;        // Boolean value for indicating if the matrix display is initialized
 } matrix_display_t;
 
@@ -45,15 +64,33 @@ void matrix_display_init(matrix_display_t* display);
 // Deinitializes the matrix display given to the function
 void matrix_display_deinit(matrix_display_t* display);
 
+// Writes the setup commands with the remembered settings and clears the display RAM, returns false if the display did not respond
+bool matrix_display_setup(matrix_display_t* display);
+// Checks if the matrix display responds and still holds its setup with a single one byte read, returns false if it has to be set up again
+bool matrix_display_check_health(matrix_display_t* display);
+
 // Sets the value (on/off : 1/0) of a pixel on the matrix display at a certain x and y position
 void matrix_display_set_pixel(matrix_display_t* display, uint8_t x, uint8_t y, bool is_on);
 // Sets the values (on/off : 1/0) of multiple pixels on the matrix display
 void matrix_display_set_pixels(matrix_display_t* display, matrix_display_value_pair_t* pixel_values, unsigned int length);
-// Updates the matrix display with the data in the buffer
+// Returns the value (on/off : 1/0) of a pixel on the matrix display at a certain x and y position
+bool matrix_display_get_pixel(matrix_display_t* display, uint8_t x, uint8_t y);
+// Returns the values of the pixels on row [y] of the matrix display, bit x is the pixel at x
+uint8_t matrix_display_get_row(matrix_display_t* display, uint8_t y);
+// Updates the matrix display with the dirty rows that differ from what was last written to the display
 void matrix_display_update(matrix_display_t* display);
-// Sets the values of all the pixels of the matrix display given to the function to (off : 0) essentially clearing the matrix display
+// Sets the values of all the pixels of the matrix display given to the function to (off : 0), the display is cleared on the next update
 void matrix_display_clear(matrix_display_t* display);
 
+// Sets the brightness level (0 to MATRIX_DISPLAY_MAX_BRIGHTNESS) of the matrix display, nothing is written when the level did not change
+void matrix_display_set_brightness(matrix_display_t* display, uint8_t brightness);
+// Sets the blink rate of the matrix display, nothing is written when the blink rate did not change
+void matrix_display_set_blink(matrix_display_t* display, matrix_display_blink_t blink);
+// Turns the LEDs of the matrix display on or off without changing the display RAM, nothing is written when the state did not change
+void matrix_display_set_display_on(matrix_display_t* display, bool is_on);
+// Stops (standby) or starts the oscillator of the matrix display, the display RAM is kept during standby, nothing is written when the state did not change
+void matrix_display_set_standby(matrix_display_t* display, bool is_standby);
+
 #ifdef __cplusplus
 }
 #endif
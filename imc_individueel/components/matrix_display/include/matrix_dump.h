@@ -0,0 +1,69 @@
+/*
+    Author: Kenley Strik
+    Addition: This whole file was written by Kenley Strik
+*/
+
+#ifndef MATRIX_DUMP_H
+#define MATRIX_DUMP_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "matrix_array.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*
+    Layout of a dump stream, all values are little endian:
+    header      "MXFB", version (1 byte), orientation (1 byte), panel count (2 bytes), width (2 bytes), height (2 bytes), 4 reserved bytes
+    frame       MATRIX_DUMP_RECORD_FRAME, 8 row bytes per panel (bit x is the pixel at x), FNV-1a hash of the row bytes (4 bytes)
+    repeat      MATRIX_DUMP_RECORD_REPEAT, ammount of frames (2 bytes) that are the same as the frame before them
+*/
+#define MATRIX_DUMP_MAGIC "MXFB"           // First bytes of every dump stream
+#define MATRIX_DUMP_VERSION 1              // Version of the layout written by this version of matrix_dump
+#define MATRIX_DUMP_HEADER_SIZE 16         // Size in bytes of the header at the start of a dump stream
+#define MATRIX_DUMP_RECORD_FRAME 0x01      // Record holding the rows of all the panels of a frame
+#define MATRIX_DUMP_RECORD_REPEAT 0x02     // Record counting frames that did not change
+#define MATRIX_DUMP_MAX_REPEAT 0xFFFF      // Maximum ammount of frames one repeat record counts
+
+// Function the dump stream is written with, returns false when the bytes could not be written
+typedef bool (*matrix_dump_write_t)(void* context, const uint8_t* data, size_t length);
+
+// Type for representing a recording of the pixels of a matrix array, one frame per capture
+typedef struct
+{
+    matrix_dump_write_t write;              // Function the dump stream is written with
+    void* context;                          // Pointer passed to the write function, for example a FILE*
+    unsigned int panel_count;               // Ammount of panels in every frame
+    uint8_t* frame;                         // Rows of the frame that is being captured, 8 bytes per panel
+    uint8_t* last_frame;                    // Rows of the last frame that was written
+    unsigned int repeat_count;              // Ammount of captured frames that were the same as the last frame and are not written yet
+    unsigned long frame_count;              // Ammount of frames captured
+    uint32_t last_hash;                     // Hash of the last frame that was captured
+    bool has_frame;                         // Boolean value for indicating if a frame was written
+    bool has_failed;                        // Boolean value for indicating if the write function failed, nothing is written after that
+    bool is_initialized;                    // Boolean value for indicating if the dump is initialized
+} matrix_dump_t;
+
+// Initializes the dump given to the function for the panels of the matrix array and writes the header, returns false if there was not enough memory or the header could not be written
+bool matrix_dump_init(matrix_dump_t* dump, matrix_array_t** array, matrix_dump_write_t write, void* context);
+// Writes the repeat count that is not written yet and deinitializes the dump given to the function
+void matrix_dump_deinit(matrix_dump_t* dump);
+
+// Captures the rows all the panels of the matrix array show as the next frame, returns the hash of the frame
+uint32_t matrix_dump_capture(matrix_dump_t* dump, matrix_array_t** array);
+// Captures [rows] (8 bytes per panel) as the next frame, for recording panels that are not part of a matrix array, returns the hash of the frame
+uint32_t matrix_dump_capture_rows(matrix_dump_t* dump, const uint8_t* rows);
+
+// Returns the FNV-1a hash of [length] bytes at [data], the hash a frame record stores for its rows
+uint32_t matrix_dump_hash(const uint8_t* data, size_t length);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif  // MATRIX_DUMP_H
\ No newline at end of file
@@ -0,0 +1,82 @@
+/*
+    Author: Kenley Strik
+    Addition: This whole file was written by Kenley Strik
+*/
+
+#ifndef MATRIX_GRAYSCALE_H
+#define MATRIX_GRAYSCALE_H
+
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+#include "freertos/semphr.h"
+#include "esp_timer.h"
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <string.h>
+
+#include "matrix_array.h"
+#include "matrix_bitmap.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define MATRIX_GRAYSCALE_MIN_PLANES 2      // Minimum ammount of bitplanes, 4 intensity levels
+#define MATRIX_GRAYSCALE_MAX_PLANES 4      // Maximum ammount of bitplanes, 16 intensity levels
+
+/*
+    Type for representing a grayscale mode for a matrix array, every pixel has a level of [plane_count] bits stored in one bitplane per bit,
+    a refresh task shows bitplane n for 2^n times the base period so the pixels seem to have the intensity of their level
+*/
+typedef struct
+{
+    matrix_array_t* array;                                      // Matrix array the bitplanes are shown on
+    unsigned int plane_count;                                   // Ammount of bitplanes, the levels go from 0 to 2^plane_count - 1
+    matrix_bitmap_t planes[MATRIX_GRAYSCALE_MAX_PLANES];        // Bitplanes that are drawn on, bitplane n holds bit n of the levels
+    matrix_bitmap_t presented_planes[MATRIX_GRAYSCALE_MAX_PLANES];  // Copy of the bitplanes made when the frame was presented
+    matrix_bitmap_t shown_planes[MATRIX_GRAYSCALE_MAX_PLANES];  // Bitplanes the refresh task cycles through
+    uint8_t plane_order[MATRIX_GRAYSCALE_MAX_PLANES];           // Order the refresh task shows the bitplanes in, chosen so the fewest bytes change
+    SemaphoreHandle_t frame_mutex;                              // Mutex for handing a presented frame to the refresh task
+    bool has_new_frame;                                         // Boolean value for indicating if a frame was presented the refresh task has not picked up yet
+
+    int64_t base_period;                                        // Time in microseconds bitplane 0 is shown for every cycle
+    TaskHandle_t task_handle;                                   // Handle of the refresh task
+    esp_timer_handle_t hold_timer;                              // Timer that wakes the refresh task when a bitplane was shown long enough
+    SemaphoreHandle_t stopped_semaphore;                        // Semaphore the refresh task gives when it has stopped
+    bool is_stopping;                                           // Boolean value for indicating if the refresh task has to stop
+
+    unsigned int cycle_count;                                   // Ammount of times all the bitplanes were shown
+    float refresh_rate;                                         // Cycles per second during the last whole second
+    int64_t rate_window_start;                                  // Time in microseconds at which the current second for counting cycles started
+    unsigned int rate_window_cycles;                            // Ammount of cycles in the current second
+    bool is_running;                                            // Boolean value for indicating if the refresh task is running
+    bool is_initialized;                                        // Boolean value for indicating if the grayscale mode is initialized
+} matrix_grayscale_t;
+
+// Initializes the grayscale mode given to the function with [plane_count] (2 to 4) bitplanes the size of the matrix array, returns false if there was not enough memory
+bool matrix_grayscale_init(matrix_grayscale_t* grayscale, matrix_array_t** array, unsigned int plane_count);
+// Deinitializes the grayscale mode given to the function, the refresh task is stopped first
+void matrix_grayscale_deinit(matrix_grayscale_t* grayscale);
+
+// Starts the refresh task pinned to core [core_id] (or tskNO_AFFINITY) that takes over the matrix displays, bitplane 0 is shown for [base_period] microseconds
+void matrix_grayscale_start(matrix_grayscale_t* grayscale, unsigned int base_period, BaseType_t core_id);
+// Stops the refresh task and gives the matrix displays back to the framebuffer of the matrix array
+void matrix_grayscale_stop(matrix_grayscale_t* grayscale);
+
+// Sets the level (0 to 2^plane_count - 1) of the pixel at a certain x and y position
+void matrix_grayscale_set_pixel(matrix_grayscale_t* grayscale, int x, int y, uint8_t level);
+// Returns the level of the pixel at a certain x and y position, pixels outside the matrix array are 0
+uint8_t matrix_grayscale_get_pixel(matrix_grayscale_t* grayscale, int x, int y);
+// Sets the level of all the pixels in the rectangle at [x, y] of [width] x [height] pixels
+void matrix_grayscale_fill_rect(matrix_grayscale_t* grayscale, int x, int y, int width, int height, uint8_t level);
+// Sets the level of all the pixels to 0
+void matrix_grayscale_clear(matrix_grayscale_t* grayscale);
+// Hands the drawn bitplanes to the refresh task, which shows them from its next cycle on
+void matrix_grayscale_present(matrix_grayscale_t* grayscale);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif  // MATRIX_GRAYSCALE_H
\ No newline at end of file
@@ -5,6 +5,33 @@
 
 #include "include/matrix_array.h"
 
+#define MATRIX_ARRAY_FLUSH_START_BIT(port) (1 << (port))        // Event bit telling the worker task of bus [port] to start updating
+#define MATRIX_ARRAY_FLUSH_DONE_BIT(port) (1 << ((port) + 8))   // Event bit telling the update that the worker task of bus [port] is done
+#define MATRIX_ARRAY_SETUP_DONE_BIT(port) (1 << ((port) + 16))  // Event bit telling the array that the setup task of bus [port] is done
+#define MATRIX_ARRAY_HEALTH_STOPPED_BIT (1 << 20)                // Event bit telling the array that the health task has stopped
+
+static const uint32_t MATRIX_ARRAY_WORKER_STACK_SIZE = 2048;
+static const UBaseType_t MATRIX_ARRAY_WORKER_PRIORITY = 5;
+static const UBaseType_t MATRIX_ARRAY_HEALTH_PRIORITY = 1;     // The health checks run when nothing else has to
+
+void matrix_array_mark_dirty(matrix_array_t* array, int x, int y, int width, int height);
+void matrix_array_mark_display_dirty(matrix_array_t* array, unsigned int index, uint8_t rows);
+void matrix_array_add_dirty_region(matrix_array_t* array, int x, int y, int width, int height);
+void matrix_array_grow_region(matrix_array_region_t* region, int x, int y, int width, int height);
+void matrix_array_mark_byte_dirty(matrix_array_t* array, unsigned int index);
+matrix_bitmap_t* matrix_array_get_bitmap(matrix_array_t* array, int layer);
+void matrix_array_mark_drawn(matrix_array_t* array, int layer, int x, int y, int width, int height);
+void matrix_array_shift_view(matrix_array_t* array, int dx, int dy);
+void matrix_array_present_canvas(matrix_array_t* array);
+void matrix_array_flush_bus(matrix_array_t* array, i2c_port_t i2c_port);
+void matrix_array_bus_worker_task(void* pvParameter);
+void matrix_array_setup_bus(matrix_array_t* array, i2c_port_t i2c_port);
+void matrix_array_setup_task(void* pvParameter);
+void matrix_array_fade_timer_callback(void* arg);
+void matrix_array_resend_recovered(matrix_array_t* array);
+void matrix_array_health_task(void* pvParameter);
+bool matrix_array_resize_batch_buffers(matrix_array_t* array, const matrix_bitmap_t* framebuffer);
+
 // Initializes the matrix array given to the function
 void matrix_array_init(matrix_array_t** array, display_orientation_t orientation)
 {
@@ -12,8 +39,54 @@ void matrix_array_init(matrix_array_t** array, display_orientation_t orientation
     if(!(*array)->is_initialized)
     {
         (*array)->orientation = orientation;   // Set orentation
+        // Set framebuffer to an empty surface that grows by one matrix display in the direction of the orientation
+        matrix_bitmap_init(&(*array)->framebuffer, (orientation == HORIZONTAL) ? 0 : 8, (orientation == HORIZONTAL) ? 8 : 0);
         (*array)->matrix_displays = NULL;      // Set pointer of matix display array to a null pointer (empty)
         (*array)->matrix_display_count = 0;    // Set matrix display count to 0
+        (*array)->dirty_displays = NULL;       // Set dirty and lit matrix displays to none
+        (*array)->lit_displays = NULL;
+        (*array)->dirty_region = (matrix_array_region_t){ 0, 0, 0, 0 };
+        (*array)->batch_set_masks = NULL;      // Set batch buffers to empty
+        (*array)->batch_clear_masks = NULL;
+        (*array)->batch_touched_bytes = NULL;
+        (*array)->batch_size = 0;
+        (*array)->layer_count = 0;             // Set layers to none, drawing happens on the framebuffer directly
+        (*array)->draw_layer = MATRIX_ARRAY_FRAMEBUFFER;
+        (*array)->canvas = (matrix_bitmap_t){ NULL, 0, 0, 0 };  // Set canvas to none, it is attached separately
+        (*array)->canvas_layer = MATRIX_ARRAY_FRAMEBUFFER;
+        (*array)->viewport_x = 0;
+        (*array)->viewport_y = 0;
+        (*array)->canvas_region = (matrix_array_region_t){ 0, 0, 0, 0 };
+        (*array)->last_flush_time = 0;         // Set duration of the last update to 0
+        (*array)->setup_time = 0;              // Set duration of the matrix display setup and time of the first frame to 0 (not happened yet)
+        (*array)->first_frame_time = 0;
+        (*array)->is_grayscale = false;        // Set the matrix displays to be updated by matrix_array_update
+        (*array)->health_task_handle = NULL;   // Set the health of the matrix displays to not be checked
+        (*array)->health_check_period = 0;
+        (*array)->is_health_stopping = false;
+        (*array)->has_recovered_displays = false;
+
+        // Set all the I2C buses to be updated by the task calling matrix_array_update
+        for(int i = 0; i < I2C_NUM_MAX; i++)
+        {
+            (*array)->bus_workers[i].array = *array;
+            (*array)->bus_workers[i].i2c_port = (i2c_port_t)i;
+            (*array)->bus_workers[i].task_handle = NULL;
+            (*array)->bus_workers[i].is_stopping = false;
+            (*array)->bus_workers[i].last_flush_time = 0;
+        }
+        (*array)->flush_events = xEventGroupCreate();   // Create event group for starting and joining the worker tasks
+
+        // Create the timer that steps the brightness of the matrix displays during a fade
+        esp_timer_create_args_t fade_timer_args = {
+            .callback = &matrix_array_fade_timer_callback,
+            .arg = *array,
+            .name = "matrix_array_fade"
+        };
+        (*array)->fade_timer = NULL;
+        esp_timer_create(&fade_timer_args, &(*array)->fade_timer);
+        (*array)->fade_target = MATRIX_DISPLAY_DEFAULT_BRIGHTNESS;
+
         (*array)->is_initialized = true;       // Set initialization state to intialized
     }
 }
@@ -24,6 +97,16 @@ void matrix_array_deinit(matrix_array_t** array)
     // Check if matrix array is inititialied
     if((*array)->is_initialized)
     { 
+        matrix_array_stop_bus_workers(array);  // Stop the worker tasks before the matrix displays they update are removed
+        matrix_array_stop_health_check(array); // Stop the health task before the matrix displays it checks are removed
+        vEventGroupDelete((*array)->flush_events);
+        if((*array)->fade_timer != NULL)
+        {
+            esp_timer_stop((*array)->fade_timer);   // Stop a running fade before the matrix displays it changes are removed
+            esp_timer_delete((*array)->fade_timer);
+            (*array)->fade_timer = NULL;
+        }
+
         if((*array)->matrix_displays != NULL)
         {
             // Loop through all the matrix displays and deinitialize them
@@ -31,15 +114,33 @@ void matrix_array_deinit(matrix_array_t** array)
                 matrix_display_deinit(&(*array)->matrix_displays[i]);
 
             free((*array)->matrix_displays);   // Free the memory of the pointer for the array of matrix displays
+            (*array)->matrix_displays = NULL;
         }
+        matrix_bitmap_deinit(&(*array)->framebuffer);   // Free the memory of the framebuffer
+        free((*array)->dirty_displays);        // Free the memory of the dirty and lit matrix displays
+        free((*array)->lit_displays);
+        (*array)->dirty_displays = NULL;
+        (*array)->lit_displays = NULL;
+        free((*array)->batch_set_masks);       // Free the memory of the batch buffers
+        free((*array)->batch_clear_masks);
+        free((*array)->batch_touched_bytes);
+        (*array)->batch_set_masks = NULL;
+        (*array)->batch_clear_masks = NULL;
+        (*array)->batch_touched_bytes = NULL;
+        (*array)->batch_size = 0;
+        for(int i = 0; i < (*array)->layer_count; i++)
+            matrix_bitmap_deinit(&(*array)->layers[i].bitmap);   // Free the memory of the layers
+        (*array)->layer_count = 0;
+        (*array)->draw_layer = MATRIX_ARRAY_FRAMEBUFFER;
+        matrix_bitmap_deinit(&(*array)->canvas);   // Free the memory of the canvas
 
         (*array)->matrix_display_count = 0;    // Set matrix display count back to 0
         (*array)->is_initialized = false;      // Set initialization state to unintialized
     }
 }
 
-// Checks if one of the matrix displays that is already part of the array has the same i2c address
-bool matrix_array_display_exists(matrix_array_t** array, uint8_t i2c_address)
+// Checks if one of the matrix displays that is already part of the array has the same i2c bus and address
+bool matrix_array_display_exists(matrix_array_t** array, i2c_port_t i2c_port, uint8_t i2c_address)
 {
     // Check if matrix array is inititialied and there are matrix display's present in the matrix array
     if((*array)->is_initialized && (*array)->matrix_displays != NULL)
@@ -47,57 +148,493 @@ bool matrix_array_display_exists(matrix_array_t** array, uint8_t i2c_address)
         // Loop through all the matrix displays in the array and check there i2c addresses
         for(int i = 0; i < (*array)->matrix_display_count; i++)
         {
-            if((*array)->matrix_displays[i].i2c_address == i2c_address)
+            if((*array)->matrix_displays[i].i2c_port == i2c_port && (*array)->matrix_displays[i].i2c_address == i2c_address)
                 return true;
         }
     }
     return false;
 }
 
-// Adds a matrix display to the array
-void matrix_array_add_matrix_display(matrix_array_t** array, uint8_t i2c_address)
+// Adds a matrix display connected to I2C bus [i2c_port] to the array, returns false if there was not enough memory
+bool matrix_array_add_matrix_display(matrix_array_t** array, i2c_port_t i2c_port, uint8_t i2c_address)
 {
-    /*
-        Check if matrix array is inititialied and if matrix display with corresponding i2c address already exists in the array, 
-        if not adds a new matrix display to the array
-    */
-    if((*array)->is_initialized && !matrix_array_display_exists(array, i2c_address))
+    matrix_array_display_address_t address = { i2c_port, i2c_address };
+    return matrix_array_add_matrix_displays(array, &address, 1);
+}
+
+/*
+    Adds [count] matrix displays to the array at once, the buffers grow only once and the matrix displays on every I2C bus
+    are set up by their own task so all buses are set up in parallel. Returns false if there was not enough memory, the
+    array is left as it was then
+*/
+bool matrix_array_add_matrix_displays(matrix_array_t** array, const matrix_array_display_address_t* addresses, unsigned int count)
+{
+    // Check if matrix array is inititialied
+    if(!(*array)->is_initialized)
+        return false;
+
+    int64_t start_time = esp_timer_get_time();
+    esp_timer_stop((*array)->fade_timer);      // Stop a running fade, the matrix displays it steps through are moved
+
+    // Stop the health task while the matrix displays it checks are moved, it is started again at the end
+    TaskHandle_t health_task_handle = (*array)->health_task_handle;
+    matrix_array_stop_health_check(array);
+    unsigned int first_index = (*array)->matrix_display_count;
+
+    // Allocate enough memory for all the new matrix displays (realloc behaves like malloc for a null pointer)
+    matrix_display_t* matrix_displays = (matrix_display_t*)realloc((*array)->matrix_displays, sizeof(matrix_display_t) * (first_index + count));
+    if(matrix_displays == NULL && first_index + count > 0)
+    {
+        if(health_task_handle != NULL)
+            matrix_array_start_health_check(array, (*array)->health_check_period, (*array)->health_check_core);
+        return false;
+    }
+    (*array)->matrix_displays = matrix_displays;
+
+    // Add the matrix displays whose i2c bus and address are not part of the array yet
+    for(int i = 0; i < count; i++)
     {
+        if(matrix_array_display_exists(array, addresses[i].i2c_port, addresses[i].i2c_address))
+            continue;
+
         matrix_display_t display = {
-            .i2c_address = i2c_address      // Set i2c address of the matrix display
+            .i2c_port = addresses[i].i2c_port,          // Set i2c bus of the matrix display
+            .i2c_address = addresses[i].i2c_address     // Set i2c address of the matrix display
         };
-        matrix_display_init(&display);      // Initialize the matrix display
+        (*array)->matrix_displays[(*array)->matrix_display_count] = display;   // Adds matrix display to the matris display array
         (*array)->matrix_display_count++;   // Increment the matrix display count
+    }
+    if((*array)->matrix_display_count == first_index)
+    {
+        if(health_task_handle != NULL)
+            matrix_array_start_health_check(array, (*array)->health_check_period, (*array)->health_check_core);
+        return true;
+    }
+
+    // Allocate the grown framebuffer and layers before the old ones are freed, so the array is left as it was when there is not enough memory
+    unsigned int size = (*array)->matrix_display_count * 8;
+    matrix_bitmap_t framebuffer;
+    matrix_bitmap_t layer_bitmaps[MATRIX_ARRAY_MAX_LAYERS];
+    unsigned int layer_bitmap_count = 0;
+    bool has_memory = (*array)->orientation == HORIZONTAL ? matrix_bitmap_init(&framebuffer, size, 8) : matrix_bitmap_init(&framebuffer, 8, size);
+    while(has_memory && layer_bitmap_count < (*array)->layer_count)
+    {
+        has_memory = matrix_bitmap_init(&layer_bitmaps[layer_bitmap_count], framebuffer.width, framebuffer.height);
+        layer_bitmap_count++;
+    }
+
+    // The batch buffers and the bits of the dirty and lit matrix displays only grow, they can stay grown when something else fails
+    has_memory = has_memory && matrix_array_resize_batch_buffers(*array, &framebuffer);
+    unsigned int old_word_count = (first_index + 31) / 32;
+    unsigned int word_count = ((*array)->matrix_display_count + 31) / 32;
+    if(has_memory && word_count > old_word_count)
+    {
+        uint32_t* dirty_displays = (uint32_t*)realloc((*array)->dirty_displays, sizeof(uint32_t) * word_count);
+        if(dirty_displays != NULL)
+            (*array)->dirty_displays = dirty_displays;
+        uint32_t* lit_displays = (uint32_t*)realloc((*array)->lit_displays, sizeof(uint32_t) * word_count);
+        if(lit_displays != NULL)
+            (*array)->lit_displays = lit_displays;
+        has_memory = dirty_displays != NULL && lit_displays != NULL;
+    }
+
+    if(!has_memory)
+    {
+        // Free what was allocated and forget the new matrix displays
+        matrix_bitmap_deinit(&framebuffer);
+        for(int i = 0; i < layer_bitmap_count; i++)
+            matrix_bitmap_deinit(&layer_bitmaps[i]);
+        (*array)->matrix_display_count = first_index;
+        if(health_task_handle != NULL)
+            matrix_array_start_health_check(array, (*array)->health_check_period, (*array)->health_check_core);
+        return false;
+    }
+
+    // Replace the framebuffer by the grown one, the framebuffer is cleared and the displays are cleared on the next update
+    matrix_bitmap_deinit(&(*array)->framebuffer);
+    (*array)->framebuffer = framebuffer;
+    matrix_array_bind_displays(array, &(*array)->framebuffer);
 
-        // Allocate enough memory to the matrix display's array
-        if((*array)->matrix_displays == NULL)
-            (*array)->matrix_displays = (matrix_display_t*)malloc(sizeof(matrix_display_t*));
+    // Replace the layers by the grown ones, their pixels are cleared as well
+    for(int i = 0; i < (*array)->layer_count; i++)
+    {
+        matrix_bitmap_deinit(&(*array)->layers[i].bitmap);
+        (*array)->layers[i].bitmap = layer_bitmaps[i];
+        (*array)->layers[i].has_changed = true;
+    }
+
+    // The viewport of the canvas grew with the framebuffer, so all of it has to be shown again
+    matrix_array_grow_region(&(*array)->canvas_region, (*array)->viewport_x, (*array)->viewport_y,
+            (*array)->framebuffer.width, (*array)->framebuffer.height);
+
+    // The bits of the new matrix displays start out cleared
+    for(int word = old_word_count; word < word_count; word++)
+    {
+        (*array)->dirty_displays[word] = 0;
+        (*array)->lit_displays[word] = 0;
+    }
+
+    // Start a setup task for every other bus with new matrix displays, the first bus is set up by this task in the meantime
+    EventBits_t done_bits = 0;
+    int own_port = -1;
+    for(int port = 0; port < I2C_NUM_MAX; port++)
+    {
+        bool has_new_display = false;
+        for(int i = first_index; i < (*array)->matrix_display_count; i++)
+            has_new_display |= ((*array)->matrix_displays[i].i2c_port == port);
+        if(!has_new_display)
+            continue;
+
+        if(own_port < 0)
+        {
+            own_port = port;
+            continue;
+        }
+
+        xEventGroupClearBits((*array)->flush_events, MATRIX_ARRAY_SETUP_DONE_BIT(port));
+        if(xTaskCreate(&matrix_array_setup_task, "matrix_setup", MATRIX_ARRAY_WORKER_STACK_SIZE,
+                &(*array)->bus_workers[port], MATRIX_ARRAY_WORKER_PRIORITY, NULL) == pdPASS)
+            done_bits |= MATRIX_ARRAY_SETUP_DONE_BIT(port);
         else
-            (*array)->matrix_displays = (matrix_display_t*)realloc((*array)->matrix_displays, sizeof(matrix_display_t) * (*array)->matrix_display_count);
-        (*array)->matrix_displays[(*array)->matrix_display_count - 1] = display;    // Adds matrix display to the matris display array
+            matrix_array_setup_bus(*array, (i2c_port_t)port);   // Set up the bus on this task if there is no memory for a task
+    }
+    if(own_port >= 0)
+        matrix_array_setup_bus(*array, (i2c_port_t)own_port);
+
+    // Join the setup tasks, the matrix displays are set up when the slowest bus is set up
+    if(done_bits != 0)
+        xEventGroupWaitBits((*array)->flush_events, done_bits, pdTRUE, pdTRUE, portMAX_DELAY);
+
+    // The new matrix displays take over the brightness, blink rate and on and standby states of the first one
+    if(first_index > 0)
+    {
+        matrix_display_t* first = &(*array)->matrix_displays[0];
+        for(int i = first_index; i < (*array)->matrix_display_count; i++)
+        {
+            matrix_display_t* added = &(*array)->matrix_displays[i];
+            matrix_display_set_brightness(added, first->brightness);
+            matrix_display_set_blink(added, first->blink);
+            matrix_display_set_display_on(added, first->is_display_on);
+            matrix_display_set_standby(added, first->is_standby);
+        }
     }
+
+    // The framebuffer was cleared so every matrix display has to be checked on the next update
+    matrix_array_mark_dirty(*array, 0, 0, (*array)->framebuffer.width, (*array)->framebuffer.height);
+
+    (*array)->setup_time = esp_timer_get_time() - start_time;
+
+    if(health_task_handle != NULL)
+        matrix_array_start_health_check(array, (*array)->health_check_period, (*array)->health_check_core);
+    return true;
 }
 
-// Sets the value (on/off : 1/0) of a pixel on the corresponding matrix display on the array at a certain x and y position
-void matrix_array_set_pixel(matrix_array_t** array, int x, int y, bool is_on)
+// Initializes the matrix displays on I2C bus [i2c_port] that are not initialized yet
+void matrix_array_setup_bus(matrix_array_t* array, i2c_port_t i2c_port)
 {
-    // Check if matrix array is inititialied
-    if((*array)->is_initialized)
+    for(int i = 0; i < array->matrix_display_count; i++)
     {
-        // Checks if the matrix array has a horizontal orientation to know how to index the matrix display array correctly
+        if(array->matrix_displays[i].i2c_port == i2c_port && !array->matrix_displays[i].is_initialized)
+            matrix_display_init(&array->matrix_displays[i]);    // Initialize the matrix display
+    }
+}
+
+// Function for a setup task that initializes the new matrix displays on its I2C bus while the other buses are set up
+void matrix_array_setup_task(void* pvParameter)
+{
+    // Cast void pointer that was passed to the task as parameter to the worker of the bus that is set up
+    matrix_array_bus_worker_t* worker = (matrix_array_bus_worker_t*)pvParameter;
+
+    matrix_array_setup_bus(worker->array, worker->i2c_port);
+    xEventGroupSetBits(worker->array->flush_events, MATRIX_ARRAY_SETUP_DONE_BIT(worker->i2c_port));   // Report the bus is set up
+    vTaskDelete(NULL);  // Delete the task, it is not needed anymore
+}
+
+// Grows the batch buffers to the size of the largest bitmap that can be drawn on ([framebuffer], which the layers have the size of, or the canvas), returns false if there was not enough memory
+bool matrix_array_resize_batch_buffers(matrix_array_t* array, const matrix_bitmap_t* framebuffer)
+{
+    unsigned int size = framebuffer->stride * framebuffer->height;
+    unsigned int canvas_size = array->canvas.stride * array->canvas.height;
+    if(canvas_size > size)
+        size = canvas_size;
+    if(size <= array->batch_size)
+        return true;
+
+    // The masks must start out cleared, the old buffers are kept when the new ones can not be allocated
+    uint8_t* set_masks = (uint8_t*)calloc(size, sizeof(uint8_t));
+    uint8_t* clear_masks = (uint8_t*)calloc(size, sizeof(uint8_t));
+    unsigned int* touched_bytes = (unsigned int*)malloc(sizeof(unsigned int) * size);
+    if(set_masks == NULL || clear_masks == NULL || touched_bytes == NULL)
+    {
+        free(set_masks);
+        free(clear_masks);
+        free(touched_bytes);
+        return false;
+    }
+
+    free(array->batch_set_masks);
+    free(array->batch_clear_masks);
+    free(array->batch_touched_bytes);
+    array->batch_set_masks = set_masks;
+    array->batch_clear_masks = clear_masks;
+    array->batch_touched_bytes = touched_bytes;
+    array->batch_size = size;
+    return true;
+}
+
+// Points the rows of every matrix display to the part of [bitmap] (the size of the framebuffer) that is shown on it and marks them to be checked on the next flush
+void matrix_array_bind_displays(matrix_array_t** array, matrix_bitmap_t* bitmap)
+{
+    for(int i = 0; i < (*array)->matrix_display_count; i++)
+    {
+        matrix_display_t* display = &(*array)->matrix_displays[i];
         if((*array)->orientation == HORIZONTAL)
+            display->rows = &bitmap->data[i];                       // Display i shows byte i of every row
+        else
+            display->rows = &bitmap->data[i * 8 * bitmap->stride];  // Display i shows rows i * 8 to i * 8 + 7
+        display->row_stride = bitmap->stride;
+
+        // Only initialized displays are checked, a display that is being added is cleared by its initialization
+        if(display->is_initialized)
+            matrix_array_mark_display_dirty(*array, i, 0xFF);
+    }
+}
+
+// Adds a layer on top of the other layers that is combined with them using [blend], returns the index of the layer or -1 if there is no room
+int matrix_array_add_layer(matrix_array_t** array, layer_blend_t blend)
+{
+    // Check if matrix array is inititialied and there is room for another layer
+    if(!(*array)->is_initialized || (*array)->layer_count >= MATRIX_ARRAY_MAX_LAYERS)
+        return -1;
+
+    matrix_array_layer_t* layer = &(*array)->layers[(*array)->layer_count];
+    if(!matrix_bitmap_init(&layer->bitmap, (*array)->framebuffer.width, (*array)->framebuffer.height))
+        return -1;
+    layer->blend = blend;
+    layer->is_visible = true;
+    layer->has_changed = true;     // The first composition replaces whatever was drawn on the framebuffer directly
+
+    return (*array)->layer_count++;
+}
+
+// Selects the layer (or MATRIX_ARRAY_FRAMEBUFFER) the drawing and read-back functions use
+void matrix_array_select_layer(matrix_array_t** array, int layer)
+{
+    // Check if matrix array is inititialied and the layer exists
+    if((*array)->is_initialized && layer >= MATRIX_ARRAY_FRAMEBUFFER && layer < (int)(*array)->layer_count)
+        (*array)->draw_layer = layer;
+    else if((*array)->is_initialized && layer == MATRIX_ARRAY_CANVAS && (*array)->canvas.data != NULL)
+        (*array)->draw_layer = layer;
+}
+
+// Shows or hides a layer in the composition
+void matrix_array_set_layer_visible(matrix_array_t** array, int layer, bool is_visible)
+{
+    // Check if matrix array is inititialied and the layer exists
+    if((*array)->is_initialized && layer >= 0 && layer < (int)(*array)->layer_count && (*array)->layers[layer].is_visible != is_visible)
+    {
+        (*array)->layers[layer].is_visible = is_visible;
+        (*array)->layers[layer].has_changed = true;
+    }
+}
+
+// Combines the visible layers into the framebuffer in one pass and marks the pixels that changed, the update does this when a layer has changed
+void matrix_array_compose(matrix_array_t** array)
+{
+    // Check if matrix array is inititialied and has layers to compose
+    if(!(*array)->is_initialized || (*array)->layer_count == 0)
+        return;
+
+    matrix_bitmap_t* framebuffer = &(*array)->framebuffer;
+    unsigned int word_count = matrix_bitmap_get_word_count(framebuffer);
+    unsigned int byte_count = framebuffer->stride * framebuffer->height;
+
+    // Walk the framebuffer one word at a time and blend the same word of every visible layer from bottom to top
+    for(unsigned int word = 0; word < word_count; word++)
+    {
+        uint32_t result = 0;
+        for(int i = 0; i < (*array)->layer_count; i++)
         {
-            // Checks if x and y values are not outside possible matrix array coördinates (size is [display count] x 8)
-            if(x < ((*array)->matrix_display_count * 8) && y < 8)
-                matrix_display_set_pixel(&(*array)->matrix_displays[x / 8], x % 8, y, is_on);
+            matrix_array_layer_t* layer = &(*array)->layers[i];
+            if(!layer->is_visible)
+                continue;
+
+            uint32_t bits;
+            memcpy(&bits, &layer->bitmap.data[word * 4], sizeof(uint32_t));    // Copy the word, the byte data does not have to be aligned
+            switch(layer->blend)
+            {
+                case LAYER_BLEND_OR:
+                    result |= bits;
+                    break;
+                case LAYER_BLEND_AND_NOT:
+                    result &= ~bits;
+                    break;
+                case LAYER_BLEND_XOR:
+                    result ^= bits;
+                    break;
+            }
         }
-        else
+
+        uint32_t previous;
+        memcpy(&previous, &framebuffer->data[word * 4], sizeof(uint32_t));
+        uint32_t changed = previous ^ result;
+        if(changed == 0)
+            continue;
+        memcpy(&framebuffer->data[word * 4], &result, sizeof(uint32_t));
+
+        // Mark the rows of the matrix displays under the bytes of the word that changed, the padding after the last row is never marked
+        for(unsigned int byte = 0; byte < 4; byte++)
         {
-            // Checks if x and y values are not outside possible matrix array coördinates (size is 8 x [display count])
-            if(x < 8 && y < ((*array)->matrix_display_count * 8))
-                matrix_display_set_pixel(&(*array)->matrix_displays[y / 8], x, y % 8, is_on);
+            if(((changed >> (byte * 8)) & 0xFF) != 0 && word * 4 + byte < byte_count)
+                matrix_array_mark_byte_dirty(*array, word * 4 + byte);
         }
     }
+
+    for(int i = 0; i < (*array)->layer_count; i++)
+        (*array)->layers[i].has_changed = false;
+}
+
+// Returns the bitmap of [layer], this is a layer, the framebuffer or the canvas
+matrix_bitmap_t* matrix_array_get_bitmap(matrix_array_t* array, int layer)
+{
+    if(layer == MATRIX_ARRAY_FRAMEBUFFER)
+        return &array->framebuffer;
+    if(layer == MATRIX_ARRAY_CANVAS)
+        return &array->canvas;
+    return &array->layers[layer].bitmap;
+}
+
+// Records that the rectangle at [x, y] of [width] x [height] pixels of [layer] was drawn on
+void matrix_array_mark_drawn(matrix_array_t* array, int layer, int x, int y, int width, int height)
+{
+    /*
+        Pixels drawn on a layer reach the matrix displays through the composition, which marks what actually changed,
+        pixels drawn on the canvas are copied to the layer of the canvas on the next update when they are inside the viewport
+    */
+    if(layer == MATRIX_ARRAY_FRAMEBUFFER)
+        matrix_array_mark_dirty(array, x, y, width, height);
+    else if(layer == MATRIX_ARRAY_CANVAS)
+        matrix_array_grow_region(&array->canvas_region, x, y, width, height);
+    else
+        array->layers[layer].has_changed = true;
+}
+
+// Attaches a cleared virtual canvas of [width] x [height] pixels whose viewport is shown on [layer] (or MATRIX_ARRAY_FRAMEBUFFER), returns false if there was not enough memory
+bool matrix_array_attach_canvas(matrix_array_t** array, unsigned int width, unsigned int height, int layer)
+{
+    // Check if matrix array is inititialied and the layer exists
+    if(!(*array)->is_initialized || layer < MATRIX_ARRAY_FRAMEBUFFER || layer >= (int)(*array)->layer_count)
+        return false;
+
+    // The batch buffers have to fit the canvas as well, it can be drawn on with matrix_array_set_pixels
+    matrix_bitmap_deinit(&(*array)->canvas);
+    if(!matrix_bitmap_init(&(*array)->canvas, width, height))
+        return false;
+    if(!matrix_array_resize_batch_buffers(*array, &(*array)->framebuffer))
+    {
+        matrix_bitmap_deinit(&(*array)->canvas);
+        return false;
+    }
+    (*array)->canvas_layer = layer;
+    (*array)->viewport_x = 0;
+    (*array)->viewport_y = 0;
+
+    // Show the whole viewport of the empty canvas on the next update
+    (*array)->canvas_region = (matrix_array_region_t){ 0, 0, (*array)->framebuffer.width, (*array)->framebuffer.height };
+    return true;
+}
+
+// Moves the viewport to [x, y] on the canvas, the shown pixels are shifted and only the newly exposed rows and columns are copied from the canvas
+void matrix_array_set_viewport(matrix_array_t** array, int x, int y)
+{
+    // Check if matrix array is inititialied and has a canvas
+    if((*array)->is_initialized && (*array)->canvas.data != NULL && (x != (*array)->viewport_x || y != (*array)->viewport_y))
+    {
+        // Moving the viewport to the right moves the shown pixels to the left
+        int dx = (*array)->viewport_x - x;
+        int dy = (*array)->viewport_y - y;
+        (*array)->viewport_x = x;
+        (*array)->viewport_y = y;
+        matrix_array_shift_view(*array, dx, dy);
+    }
+}
+
+// Moves all the pixels of the canvas [dx] pixels to the right and [dy] pixels down, the shifted in rows and columns are cleared for drawing
+void matrix_array_scroll_canvas(matrix_array_t** array, int dx, int dy)
+{
+    // Check if matrix array is inititialied and has a canvas
+    if((*array)->is_initialized && (*array)->canvas.data != NULL && (dx != 0 || dy != 0))
+    {
+        matrix_bitmap_shift(&(*array)->canvas, dx, dy);
+        (*array)->canvas_region.x += dx;           // Pixels drawn since the last update moved with the canvas
+        (*array)->canvas_region.y += dy;
+        matrix_array_shift_view(*array, dx, dy);   // The shown pixels move the same way as the pixels of the canvas
+
+        // Pixels shifted past the edge of the canvas are dropped, so a viewport that sticks out of the canvas is copied again as a whole
+        if((*array)->viewport_x < 0 || (*array)->viewport_y < 0 ||
+                (*array)->viewport_x + (*array)->framebuffer.width > (*array)->canvas.width ||
+                (*array)->viewport_y + (*array)->framebuffer.height > (*array)->canvas.height)
+            matrix_array_grow_region(&(*array)->canvas_region, (*array)->viewport_x, (*array)->viewport_y,
+                    (*array)->framebuffer.width, (*array)->framebuffer.height);
+    }
+}
+
+// Moves the pixels shown of the canvas [dx] pixels to the right and [dy] pixels down and marks the exposed rows and columns to be copied from the canvas
+void matrix_array_shift_view(matrix_array_t* array, int dx, int dy)
+{
+    int width = (int)array->framebuffer.width;
+    int height = (int)array->framebuffer.height;
+
+    matrix_bitmap_shift(matrix_array_get_bitmap(array, array->canvas_layer), dx, dy);  // One shift per row instead of copying the whole viewport
+    matrix_array_mark_drawn(array, array->canvas_layer, 0, 0, width, height);
+
+    // Clamp the shift to the viewport, a larger shift exposes all of it
+    dx = (dx > width) ? width : ((dx < -width) ? -width : dx);
+    dy = (dy > height) ? height : ((dy < -height) ? -height : dy);
+
+    // Mark the columns and rows shifted in at the edges of the viewport, positioned on the canvas
+    if(dx > 0)
+        matrix_array_grow_region(&array->canvas_region, array->viewport_x, array->viewport_y, dx, height);
+    else if(dx < 0)
+        matrix_array_grow_region(&array->canvas_region, array->viewport_x + width + dx, array->viewport_y, -dx, height);
+    if(dy > 0)
+        matrix_array_grow_region(&array->canvas_region, array->viewport_x, array->viewport_y, width, dy);
+    else if(dy < 0)
+        matrix_array_grow_region(&array->canvas_region, array->viewport_x, array->viewport_y + height + dy, width, -dy);
+}
+
+// Copies the pixels of the canvas that were drawn on or exposed and are inside the viewport to the layer of the canvas
+void matrix_array_present_canvas(matrix_array_t* array)
+{
+    matrix_array_region_t region = array->canvas_region;
+    array->canvas_region = (matrix_array_region_t){ 0, 0, 0, 0 };
+
+    // Clip the region to the viewport
+    int left = (region.x > array->viewport_x) ? region.x : array->viewport_x;
+    int top = (region.y > array->viewport_y) ? region.y : array->viewport_y;
+    int right = region.x + region.width;
+    int bottom = region.y + region.height;
+    if(right > array->viewport_x + (int)array->framebuffer.width)
+        right = array->viewport_x + (int)array->framebuffer.width;
+    if(bottom > array->viewport_y + (int)array->framebuffer.height)
+        bottom = array->viewport_y + (int)array->framebuffer.height;
+    if(region.width == 0 || region.height == 0 || left >= right || top >= bottom)
+        return;
+
+    matrix_bitmap_copy_rect(matrix_array_get_bitmap(array, array->canvas_layer), left - array->viewport_x, top - array->viewport_y,
+            &array->canvas, left, top, right - left, bottom - top);
+    matrix_array_mark_drawn(array, array->canvas_layer, left - array->viewport_x, top - array->viewport_y, right - left, bottom - top);
+}
+
+// Sets the value (on/off : 1/0) of a pixel on the corresponding matrix display on the array at a certain x and y position
+void matrix_array_set_pixel(matrix_array_t** array, int x, int y, bool is_on)
+{
+    // Check if matrix array is inititialied, the framebuffer ignores x and y values outside the matrix array
+    if((*array)->is_initialized)
+    {
+        matrix_bitmap_set_pixel(matrix_array_get_bitmap(*array, (*array)->draw_layer), x, y, is_on);
+        matrix_array_mark_drawn(*array, (*array)->draw_layer, x, y, 1, 1);
+    }
 }
 
 // Sets the values (on/off : 1/0) of multiple pixels on the corresponding matrix display on the array
@@ -106,32 +643,661 @@ void matrix_array_set_pixels(matrix_array_t** array, matrix_display_value_pair_t
     // Check if matrix array is inititialied
     if((*array)->is_initialized)
     {
-        // Loop trough all pixels values pairs given and set corresponding LED values in the matrix display buffers
+        matrix_bitmap_t* framebuffer = matrix_array_get_bitmap(*array, (*array)->draw_layer);
+        uint8_t* set_masks = (*array)->batch_set_masks;
+        uint8_t* clear_masks = (*array)->batch_clear_masks;
+        unsigned int* touched_bytes = (*array)->batch_touched_bytes;
+        unsigned int touched_count = 0;
+        int left = framebuffer->width, top = framebuffer->height, right = -1, bottom = -1;
+
+        // Loop trough all pixels values pairs given and collect them per framebuffer byte, a later pair for the same pixel wins
         for(int i = 0; i < length; i++)
-            matrix_array_set_pixel(array, pixel_values[i].x, pixel_values[i].y, pixel_values[i].is_on);
+        {
+            // Checks if x and y values are not outside possible matrix array coördinates
+            int x = pixel_values[i].x;
+            int y = pixel_values[i].y;
+            if(x >= (int)framebuffer->width || y >= (int)framebuffer->height)
+                continue;
+
+            // Remember the byte the first time it is touched, once touched one of its masks is never zero again
+            unsigned int index = y * framebuffer->stride + (x >> 3);
+            if((set_masks[index] | clear_masks[index]) == 0x00)
+                touched_bytes[touched_count++] = index;
+
+            uint8_t bit = (uint8_t)(1 << (x & 7));
+            if(pixel_values[i].is_on)
+            {
+                set_masks[index] |= bit;
+                clear_masks[index] &= (uint8_t)~bit;
+            }
+            else
+            {
+                clear_masks[index] |= bit;
+                set_masks[index] &= (uint8_t)~bit;
+            }
+
+            left = (x < left) ? x : left;
+            top = (y < top) ? y : top;
+            right = (x > right) ? x : right;
+            bottom = (y > bottom) ? y : bottom;
+        }
+
+        // Apply the changes of every touched byte (one row of one matrix display) with one masked update
+        for(unsigned int i = 0; i < touched_count; i++)
+        {
+            unsigned int index = touched_bytes[i];
+            framebuffer->data[index] = (uint8_t)((framebuffer->data[index] & ~clear_masks[index]) | set_masks[index]);
+            set_masks[index] = 0x00;
+            clear_masks[index] = 0x00;
+
+            // Mark the row of the matrix display the byte belongs to
+            if((*array)->draw_layer == MATRIX_ARRAY_FRAMEBUFFER)
+            {
+                if((*array)->orientation == HORIZONTAL)
+                    matrix_array_mark_display_dirty(*array, index % framebuffer->stride, (uint8_t)(1 << (index / framebuffer->stride)));
+                else
+                    matrix_array_mark_display_dirty(*array, index / 8, (uint8_t)(1 << (index % 8)));
+            }
+        }
+
+        if(touched_count > 0)
+        {
+            if((*array)->draw_layer == MATRIX_ARRAY_FRAMEBUFFER)
+                matrix_array_add_dirty_region(*array, left, top, right - left + 1, bottom - top + 1);
+            else
+                matrix_array_mark_drawn(*array, (*array)->draw_layer, left, top, right - left + 1, bottom - top + 1);
+        }
+    }
+}
+
+// Sets the values (on/off : 1/0) of [length] pixels in a horizontal line starting at a certain x and y position
+void matrix_array_draw_hline(matrix_array_t** array, int x, int y, int length, bool is_on)
+{
+    // Check if matrix array is inititialied, the line is set one row at a time across the matrix displays
+    if((*array)->is_initialized)
+    {
+        matrix_bitmap_fill_span(matrix_array_get_bitmap(*array, (*array)->draw_layer), x, y, length, is_on);
+        matrix_array_mark_drawn(*array, (*array)->draw_layer, x, y, length, 1);
     }
 }
 
-// Updates the matrix displays with the data in the buffers
+// Sets the values (on/off : 1/0) of [length] pixels in a vertical line starting at a certain x and y position
+void matrix_array_draw_vline(matrix_array_t** array, int x, int y, int length, bool is_on)
+{
+    // Check if matrix array is inititialied
+    if((*array)->is_initialized)
+    {
+        matrix_bitmap_draw_vline(matrix_array_get_bitmap(*array, (*array)->draw_layer), x, y, length, is_on);
+        matrix_array_mark_drawn(*array, (*array)->draw_layer, x, y, 1, length);
+    }
+}
+
+// Sets the values (on/off : 1/0) of all the pixels in a rectangle of [width] x [height] pixels at a certain x and y position
+void matrix_array_fill_rect(matrix_array_t** array, int x, int y, int width, int height, bool is_on)
+{
+    // Check if matrix array is inititialied
+    if((*array)->is_initialized)
+    {
+        matrix_bitmap_fill_rect(matrix_array_get_bitmap(*array, (*array)->draw_layer), x, y, width, height, is_on);
+        matrix_array_mark_drawn(*array, (*array)->draw_layer, x, y, width, height);
+    }
+}
+
+// Sets [width] (at most 32) pixels of row [y] starting at [x] to the bits of [bits] where bit n is the pixel at x + n
+void matrix_array_set_row_bits(matrix_array_t** array, int x, int y, int width, uint32_t bits)
+{
+    // Check if matrix array is inititialied
+    if((*array)->is_initialized)
+    {
+        matrix_bitmap_set_bits(matrix_array_get_bitmap(*array, (*array)->draw_layer), x, y, width, bits);
+        matrix_array_mark_drawn(*array, (*array)->draw_layer, x, y, (width < 32) ? width : 32, 1);
+    }
+}
+
+// Moves the pixels of [height] rows starting at row [y] [dx] pixels to the right, the pixels that are shifted in are (off : 0)
+void matrix_array_shift_rows(matrix_array_t** array, int y, int height, int dx)
+{
+    // Check if matrix array is inititialied
+    if((*array)->is_initialized && dx != 0)
+    {
+        matrix_bitmap_t* bitmap = matrix_array_get_bitmap(*array, (*array)->draw_layer);
+        matrix_bitmap_shift_rows(bitmap, y, height, dx);
+        matrix_array_mark_drawn(*array, (*array)->draw_layer, 0, y, bitmap->width, height);
+    }
+}
+
+// Returns the value (on/off : 1/0) of a pixel of the selected layer or framebuffer at a certain x and y position, pixels outside the array are off
+bool matrix_array_get_pixel(matrix_array_t** array, int x, int y)
+{
+    // Check if matrix array is inititialied
+    if(!(*array)->is_initialized)
+        return false;
+
+    return matrix_bitmap_get_pixel(matrix_array_get_bitmap(*array, (*array)->draw_layer), x, y);
+}
+
+// Returns [width] (at most 32) pixels of row [y] starting at [x] packed in a mask where bit n is the pixel at x + n
+uint32_t matrix_array_get_row_bits(matrix_array_t** array, int x, int y, int width)
+{
+    // Check if matrix array is inititialied
+    if(!(*array)->is_initialized)
+        return 0;
+
+    return matrix_bitmap_get_bits(matrix_array_get_bitmap(*array, (*array)->draw_layer), x, y, width);
+}
+
+// Stores the pixels of the rectangle at [x, y] of [width] (at most 32) x [height] pixels as one packed mask per row in [rows]
+void matrix_array_get_region(matrix_array_t** array, int x, int y, int width, int height, uint32_t* rows)
+{
+    // Check if matrix array is inititialied, an uninitialized array reads as all off
+    if((*array)->is_initialized)
+        matrix_bitmap_get_region(matrix_array_get_bitmap(*array, (*array)->draw_layer), x, y, width, height, rows);
+    else
+        memset(rows, 0, sizeof(uint32_t) * height);
+}
+
+// Checks if any pixel in the packed masks of [mask_rows] (one per row, [width] at most 32) placed at [x, y] is turned on on the array
+bool matrix_array_test_mask(matrix_array_t** array, int x, int y, const uint32_t* mask_rows, int width, int height)
+{
+    // Check if matrix array is inititialied
+    if(!(*array)->is_initialized)
+        return false;
+
+    return matrix_bitmap_test_mask(matrix_array_get_bitmap(*array, (*array)->draw_layer), x, y, mask_rows, width, height);
+}
+
+// Returns the bitmap of the selected layer (or framebuffer or canvas) to draw on with the matrix_bitmap functions, the drawn pixels are marked with matrix_array_mark_region_drawn
+matrix_bitmap_t* matrix_array_get_selected_bitmap(matrix_array_t** array)
+{
+    return matrix_array_get_bitmap(*array, (*array)->draw_layer);
+}
+
+// Marks the rectangle at [x, y] of [width] x [height] pixels of the selected layer (or framebuffer or canvas) as drawn on, so the next update shows it
+void matrix_array_mark_region_drawn(matrix_array_t** array, int x, int y, int width, int height)
+{
+    // Check if matrix array is inititialied
+    if((*array)->is_initialized)
+        matrix_array_mark_drawn(*array, (*array)->draw_layer, x, y, width, height);
+}
+
+// Copies the drawn pixels of the canvas inside the viewport, composes changed layers and updates the matrix displays with the data in the buffers, every I2C bus with a worker task is updated in parallel
 void matrix_array_update(matrix_array_t** array)
+{
+    // Check if matrix array is inititialied, while the matrix displays are refreshed by a grayscale task that task updates them
+    if((*array)->is_initialized && !(*array)->is_grayscale)
+    {
+        // Show what was drawn on the canvas inside the viewport
+        if((*array)->canvas.data != NULL)
+            matrix_array_present_canvas(*array);
+
+        // Compose the framebuffer again only when one of the layers was drawn on, shown or hidden
+        for(int i = 0; i < (*array)->layer_count; i++)
+        {
+            if((*array)->layers[i].has_changed)
+            {
+                matrix_array_compose(array);
+                break;
+            }
+        }
+
+        matrix_array_flush(array);
+    }
+}
+
+// Updates the dirty matrix displays with the rows they are bound to without composing the layers, every I2C bus with a worker task is updated in parallel
+void matrix_array_flush(matrix_array_t** array)
 {
     // Check if matrix array is inititialied
     if((*array)->is_initialized)
     {
-        // Loop through all the matrix displays in the array and update them
-        for(int i = 0; i < (*array)->matrix_display_count; i++)
-            matrix_display_update(&(*array)->matrix_displays[i]);
+        int64_t start_time = esp_timer_get_time();
+
+        // Matrix displays the health task set up again get all their rows sent with this flush
+        if((*array)->has_recovered_displays)
+            matrix_array_resend_recovered(*array);
+
+        // Collect the start and done bits of all the buses that have a worker task
+        EventBits_t start_bits = 0;
+        EventBits_t done_bits = 0;
+        for(int i = 0; i < I2C_NUM_MAX; i++)
+        {
+            if((*array)->bus_workers[i].task_handle != NULL)
+            {
+                start_bits |= MATRIX_ARRAY_FLUSH_START_BIT(i);
+                done_bits |= MATRIX_ARRAY_FLUSH_DONE_BIT(i);
+            }
+        }
+
+        // Fan out the buses with a worker task and update the other buses on this task in the meantime
+        if(start_bits != 0)
+            xEventGroupSetBits((*array)->flush_events, start_bits);
+        for(int i = 0; i < I2C_NUM_MAX; i++)
+        {
+            if((*array)->bus_workers[i].task_handle == NULL)
+                matrix_array_flush_bus(*array, (i2c_port_t)i);
+        }
+
+        // Join the worker tasks, the frame is done when the slowest bus is done
+        if(done_bits != 0)
+            xEventGroupWaitBits((*array)->flush_events, done_bits, pdTRUE, pdTRUE, portMAX_DELAY);
+
+        // Remember which of the updated matrix displays have pixels turned on and reset the dirty matrix displays
+        for(int word = 0; word < ((*array)->matrix_display_count + 31) / 32; word++)
+        {
+            for(uint32_t bits = (*array)->dirty_displays[word]; bits != 0; bits &= bits - 1)
+            {
+                int bit = __builtin_ctz(bits);
+                uint8_t* sent_rows = (*array)->matrix_displays[word * 32 + bit].sent_rows;
+                bool is_lit = false;
+                for(int y = 0; y < 8; y++)
+                    is_lit |= (sent_rows[y] != 0x00);
+
+                if(is_lit)
+                    (*array)->lit_displays[word] |= (uint32_t)1 << bit;
+                else
+                    (*array)->lit_displays[word] &= ~((uint32_t)1 << bit);
+            }
+            (*array)->dirty_displays[word] = 0;
+        }
+        (*array)->dirty_region = (matrix_array_region_t){ 0, 0, 0, 0 };
+
+        (*array)->last_flush_time = esp_timer_get_time() - start_time;
+
+        // Remember when the first frame reached the matrix displays, the time since boot it took before anything could be shown
+        if((*array)->first_frame_time == 0)
+            (*array)->first_frame_time = esp_timer_get_time();
+    }
+}
+
+// Updates all the matrix displays on I2C bus [i2c_port] with the data in their buffers
+void matrix_array_flush_bus(matrix_array_t* array, i2c_port_t i2c_port)
+{
+    int64_t start_time = esp_timer_get_time();
+
+    // Loop through the dirty matrix displays in the array and update the ones connected to the bus, untouched displays are skipped
+    for(int word = 0; word < (array->matrix_display_count + 31) / 32; word++)
+    {
+        for(uint32_t bits = array->dirty_displays[word]; bits != 0; bits &= bits - 1)
+        {
+            matrix_display_t* display = &array->matrix_displays[word * 32 + __builtin_ctz(bits)];
+            if(display->i2c_port == i2c_port)
+                matrix_display_update(display);
+        }
+    }
+
+    array->bus_workers[i2c_port].last_flush_time = esp_timer_get_time() - start_time;
+}
+
+// Starts a worker task pinned to core [core_id] (or tskNO_AFFINITY) that updates the matrix displays on I2C bus [i2c_port] in parallel with the other buses
+void matrix_array_start_bus_worker(matrix_array_t** array, i2c_port_t i2c_port, BaseType_t core_id)
+{
+    // Check if matrix array is inititialied, the bus exists and does not have a worker task yet
+    if((*array)->is_initialized && i2c_port < I2C_NUM_MAX && (*array)->bus_workers[i2c_port].task_handle == NULL)
+    {
+        matrix_array_bus_worker_t* worker = &(*array)->bus_workers[i2c_port];
+        worker->is_stopping = false;
+        xEventGroupClearBits((*array)->flush_events, MATRIX_ARRAY_FLUSH_START_BIT(i2c_port) | MATRIX_ARRAY_FLUSH_DONE_BIT(i2c_port));
+
+        // Create worker task for updating the matrix displays on the bus
+        if(xTaskCreatePinnedToCore(&matrix_array_bus_worker_task, "matrix_bus_worker", MATRIX_ARRAY_WORKER_STACK_SIZE, 
+                worker, MATRIX_ARRAY_WORKER_PRIORITY, &worker->task_handle, core_id) != pdPASS)
+            worker->task_handle = NULL;
+    }
+}
+
+// Stops the worker tasks of all I2C buses, after which the matrix displays are updated by the task calling matrix_array_update
+void matrix_array_stop_bus_workers(matrix_array_t** array)
+{
+    // Check if matrix array is inititialied
+    if((*array)->is_initialized)
+    {
+        for(int i = 0; i < I2C_NUM_MAX; i++)
+        {
+            matrix_array_bus_worker_t* worker = &(*array)->bus_workers[i];
+            if(worker->task_handle != NULL)
+            {
+                // Wake the worker task with the stopping flag set and wait until it reports it is done
+                worker->is_stopping = true;
+                xEventGroupSetBits((*array)->flush_events, MATRIX_ARRAY_FLUSH_START_BIT(i));
+                xEventGroupWaitBits((*array)->flush_events, MATRIX_ARRAY_FLUSH_DONE_BIT(i), pdTRUE, pdTRUE, portMAX_DELAY);
+                worker->task_handle = NULL;
+            }
+        }
+    }
+}
+
+// Function for a worker task that updates the matrix displays on its I2C bus every time matrix_array_update fans out the work
+void matrix_array_bus_worker_task(void* pvParameter)
+{
+    // Cast void pointer that was passed to the task as parameter to the corresponding worker
+    matrix_array_bus_worker_t* worker = (matrix_array_bus_worker_t*)pvParameter;
+    matrix_array_t* array = worker->array;
+
+    while(true)
+    {
+        // Wait until the update starts a new frame
+        xEventGroupWaitBits(array->flush_events, MATRIX_ARRAY_FLUSH_START_BIT(worker->i2c_port), pdTRUE, pdTRUE, portMAX_DELAY);
+        if(worker->is_stopping)
+            break;
+
+        matrix_array_flush_bus(array, worker->i2c_port);
+        xEventGroupSetBits(array->flush_events, MATRIX_ARRAY_FLUSH_DONE_BIT(worker->i2c_port));    // Report the bus is done
+    }
+
+    xEventGroupSetBits(array->flush_events, MATRIX_ARRAY_FLUSH_DONE_BIT(worker->i2c_port));        // Report the worker task has stopped
+    vTaskDelete(NULL);  // Delete the task, it is not needed anymore
+}
+
+// Starts a health task pinned to core [core_id] (or tskNO_AFFINITY) that checks every matrix display once every [period] milliseconds and sets up the ones that were lost again
+void matrix_array_start_health_check(matrix_array_t** array, unsigned int period, BaseType_t core_id)
+{
+    // Check if matrix array is inititialied and the health task is not running yet
+    if((*array)->is_initialized && (*array)->health_task_handle == NULL)
+    {
+        (*array)->health_check_period = (period > 0) ? period : 1;
+        (*array)->health_check_core = core_id;
+        (*array)->is_health_stopping = false;
+        xEventGroupClearBits((*array)->flush_events, MATRIX_ARRAY_HEALTH_STOPPED_BIT);
+
+        // Create health task for checking the matrix displays in the background
+        if(xTaskCreatePinnedToCore(&matrix_array_health_task, "matrix_health", MATRIX_ARRAY_WORKER_STACK_SIZE,
+                *array, MATRIX_ARRAY_HEALTH_PRIORITY, &(*array)->health_task_handle, core_id) != pdPASS)
+            (*array)->health_task_handle = NULL;
+    }
+}
+
+// Stops the health task, the matrix displays are no longer checked
+void matrix_array_stop_health_check(matrix_array_t** array)
+{
+    // Check if matrix array is inititialied and the health task is running
+    if((*array)->is_initialized && (*array)->health_task_handle != NULL)
+    {
+        // Wake the health task with the stopping flag set and wait until it reports it has stopped
+        (*array)->is_health_stopping = true;
+        xTaskNotifyGive((*array)->health_task_handle);
+        xEventGroupWaitBits((*array)->flush_events, MATRIX_ARRAY_HEALTH_STOPPED_BIT, pdTRUE, pdTRUE, portMAX_DELAY);
+        (*array)->health_task_handle = NULL;
+    }
+}
+
+/*
+    Function for the health task that checks the matrix displays with one single byte read each, a display that did not respond or lost its setup
+    is skipped by the flush while it is set up again, so the healthy matrix displays are updated as usual
+*/
+void matrix_array_health_task(void* pvParameter)
+{
+    // Cast void pointer that was passed to the task as parameter to the corresponding matrix array
+    matrix_array_t* array = (matrix_array_t*)pvParameter;
+
+    while(!array->is_health_stopping)
+    {
+        for(int i = 0; i < array->matrix_display_count && !array->is_health_stopping; i++)
+        {
+            matrix_display_t* display = &array->matrix_displays[i];
+            if(!display->is_initialized || (!display->is_lost && matrix_display_check_health(display)))
+                continue;
+
+            // Take the display away from the flush and set it up again, a display that is still gone is tried again next period
+            display->is_lost = true;
+            if(matrix_display_setup(display))
+            {
+                display->recovery_count++;
+                display->is_recovered = true;       // The flush sends all the rows again before the display is updated again
+                array->has_recovered_displays = true;
+                display->is_lost = false;
+            }
+        }
+
+        // Wait for the next period, stopping the health task wakes it early
+        ulTaskNotifyTake(pdTRUE, array->health_check_period / portTICK_PERIOD_MS);
     }
+
+    xEventGroupSetBits(array->flush_events, MATRIX_ARRAY_HEALTH_STOPPED_BIT);  // Report the health task has stopped
+    vTaskDelete(NULL);  // Delete the task, it is not needed anymore
 }
 
-// Sets the values of all the pixels of the matrix displays to (off : 0) essentially clearing the matrix displays
+// Marks all the rows of the matrix displays the health task set up again to be sent, their display RAM was cleared by the setup
+void matrix_array_resend_recovered(matrix_array_t* array)
+{
+    array->has_recovered_displays = false;
+    for(int i = 0; i < array->matrix_display_count; i++)
+    {
+        matrix_display_t* display = &array->matrix_displays[i];
+        if(display->is_recovered)
+        {
+            display->is_recovered = false;
+            memset(display->sent_rows, 0x00, sizeof(display->sent_rows));
+            matrix_array_mark_display_dirty(array, i, 0xFF);
+        }
+    }
+}
+
+// Sets the values of all the pixels of the selected layer or framebuffer to (off : 0), the matrix displays are cleared on the next update
 void matrix_array_clear(matrix_array_t** array)
+{
+    // Check if matrix array is inititialied, a cleared layer or canvas reaches the matrix displays through the composition
+    if((*array)->is_initialized && (*array)->draw_layer != MATRIX_ARRAY_FRAMEBUFFER)
+    {
+        matrix_bitmap_t* bitmap = matrix_array_get_bitmap(*array, (*array)->draw_layer);
+        matrix_bitmap_clear(bitmap);
+        matrix_array_mark_drawn(*array, (*array)->draw_layer, 0, 0, bitmap->width, bitmap->height);
+    }
+    else if((*array)->is_initialized)
+    {
+        matrix_bitmap_clear(&(*array)->framebuffer);   // Clear the whole surface at once
+
+        // Only the matrix displays that have pixels turned on or were drawn on since the last update have to be checked
+        for(int word = 0; word < ((*array)->matrix_display_count + 31) / 32; word++)
+        {
+            for(uint32_t bits = (*array)->lit_displays[word] | (*array)->dirty_displays[word]; bits != 0; bits &= bits - 1)
+            {
+                unsigned int index = word * 32 + __builtin_ctz(bits);
+                matrix_display_t* display = &(*array)->matrix_displays[index];
+
+                uint8_t rows = display->dirty_rows;
+                for(int y = 0; y < 8; y++)
+                {
+                    if(display->sent_rows[y] != 0x00)
+                        rows |= (uint8_t)(1 << y);
+                }
+                matrix_array_mark_display_dirty(*array, index, rows);
+
+                if((*array)->orientation == HORIZONTAL)
+                    matrix_array_add_dirty_region(*array, index * 8, 0, 8, 8);
+                else
+                    matrix_array_add_dirty_region(*array, 0, index * 8, 8, 8);
+            }
+        }
+    }
+}
+
+// Sets the brightness level (0 to MATRIX_DISPLAY_MAX_BRIGHTNESS) of all the matrix displays and stops a running fade
+void matrix_array_set_brightness(matrix_array_t** array, uint8_t brightness)
+{
+    // Check if matrix array is inititialied
+    if((*array)->is_initialized)
+    {
+        esp_timer_stop((*array)->fade_timer);   // A brightness that is set directly replaces a running fade
+
+        // Only the matrix displays with another brightness are written to
+        for(int i = 0; i < (*array)->matrix_display_count; i++)
+            matrix_display_set_brightness(&(*array)->matrix_displays[i], brightness);
+    }
+}
+
+/*
+    Changes the brightness of all the matrix displays to [brightness] in [duration] milliseconds, the timer moves every matrix display
+    one level closer at every step, so a fade only writes one brightness command per matrix display and level and never touches the display RAM
+*/
+void matrix_array_fade_brightness(matrix_array_t** array, uint8_t brightness, unsigned int duration)
 {
     // Check if matrix array is inititialied
     if((*array)->is_initialized)
     {
-        // Loop through all the matrix displays in the array and clear them
+        if(brightness > MATRIX_DISPLAY_MAX_BRIGHTNESS)
+            brightness = MATRIX_DISPLAY_MAX_BRIGHTNESS;
+        esp_timer_stop((*array)->fade_timer);   // A new fade replaces a running fade
+
+        // The matrix display that is furthest from the target sets the number of steps
+        int step_count = 0;
         for(int i = 0; i < (*array)->matrix_display_count; i++)
-            matrix_display_clear(&(*array)->matrix_displays[i]);
+        {
+            int distance = abs((int)(*array)->matrix_displays[i].brightness - (int)brightness);
+            if(distance > step_count)
+                step_count = distance;
+        }
+
+        // Without steps or time to take them the brightness is set right away
+        uint64_t step_period = (step_count > 0) ? (uint64_t)duration * 1000 / step_count : 0;
+        if(step_period == 0)
+        {
+            matrix_array_set_brightness(array, brightness);
+            return;
+        }
+
+        (*array)->fade_target = brightness;
+        esp_timer_start_periodic((*array)->fade_timer, step_period);
+    }
+}
+
+// Callback function for the fade timer moving the brightness of every matrix display one level closer to the fade target
+void matrix_array_fade_timer_callback(void* arg)
+{
+    matrix_array_t* array = (matrix_array_t*)arg;
+    bool is_done = true;
+
+    for(int i = 0; i < array->matrix_display_count; i++)
+    {
+        matrix_display_t* display = &array->matrix_displays[i];
+        if(display->brightness < array->fade_target)
+            matrix_display_set_brightness(display, display->brightness + 1);
+        else if(display->brightness > array->fade_target)
+            matrix_display_set_brightness(display, display->brightness - 1);
+        is_done &= (display->brightness == array->fade_target);
+    }
+
+    // Stop the timer once every matrix display reached the target
+    if(is_done)
+        esp_timer_stop(array->fade_timer);
+}
+
+// Sets the blink rate of all the matrix displays
+void matrix_array_set_blink(matrix_array_t** array, matrix_display_blink_t blink)
+{
+    // Check if matrix array is inititialied
+    if((*array)->is_initialized)
+    {
+        for(int i = 0; i < (*array)->matrix_display_count; i++)
+            matrix_display_set_blink(&(*array)->matrix_displays[i], blink);
+    }
+}
+
+// Turns the LEDs of all the matrix displays on or off without changing the display RAM
+void matrix_array_set_display_on(matrix_array_t** array, bool is_on)
+{
+    // Check if matrix array is inititialied
+    if((*array)->is_initialized)
+    {
+        for(int i = 0; i < (*array)->matrix_display_count; i++)
+            matrix_display_set_display_on(&(*array)->matrix_displays[i], is_on);
+    }
+}
+
+// Stops (standby) or starts the oscillator of all the matrix displays, the display RAM is kept during standby
+void matrix_array_set_standby(matrix_array_t** array, bool is_standby)
+{
+    // Check if matrix array is inititialied
+    if((*array)->is_initialized)
+    {
+        for(int i = 0; i < (*array)->matrix_display_count; i++)
+            matrix_display_set_standby(&(*array)->matrix_displays[i], is_standby);
+    }
+}
+
+// Marks the matrix display at [index] as drawn on and the rows of it in [rows] to be checked on the next update
+void matrix_array_mark_display_dirty(matrix_array_t* array, unsigned int index, uint8_t rows)
+{
+    array->matrix_displays[index].dirty_rows |= rows;
+    array->dirty_displays[index / 32] |= (uint32_t)1 << (index % 32);
+}
+
+// Marks the row of the matrix display that framebuffer byte [index] belongs to and the pixels of the byte as drawn on
+void matrix_array_mark_byte_dirty(matrix_array_t* array, unsigned int index)
+{
+    unsigned int stride = array->framebuffer.stride;
+    if(array->orientation == HORIZONTAL)
+    {
+        matrix_array_mark_display_dirty(array, index % stride, (uint8_t)(1 << (index / stride)));
+        matrix_array_add_dirty_region(array, (index % stride) * 8, index / stride, 8, 1);
+    }
+    else
+    {
+        matrix_array_mark_display_dirty(array, index / 8, (uint8_t)(1 << (index % 8)));
+        matrix_array_add_dirty_region(array, 0, index, 8, 1);
+    }
+}
+
+// Grows the dirty region so it contains the rectangle at [x, y] of [width] x [height] pixels
+void matrix_array_add_dirty_region(matrix_array_t* array, int x, int y, int width, int height)
+{
+    matrix_array_grow_region(&array->dirty_region, x, y, width, height);
+}
+
+// Grows [region] so it contains the rectangle at [x, y] of [width] x [height] pixels
+void matrix_array_grow_region(matrix_array_region_t* region, int x, int y, int width, int height)
+{
+    if(region->width == 0 || region->height == 0)
+    {
+        *region = (matrix_array_region_t){ x, y, width, height };
+        return;
+    }
+
+    int right = (region->x + region->width > x + width) ? region->x + region->width : x + width;
+    int bottom = (region->y + region->height > y + height) ? region->y + region->height : y + height;
+    region->x = (region->x < x) ? region->x : x;
+    region->y = (region->y < y) ? region->y : y;
+    region->width = right - region->x;
+    region->height = bottom - region->y;
+}
+
+// Marks the rectangle at [x, y] of [width] x [height] pixels as drawn on, so the rows of the matrix displays under it are checked on the next update
+void matrix_array_mark_dirty(matrix_array_t* array, int x, int y, int width, int height)
+{
+    // Clip the rectangle to the framebuffer
+    if(x < 0)
+    {
+        width += x;
+        x = 0;
+    }
+    if(y < 0)
+    {
+        height += y;
+        y = 0;
+    }
+    if(x + width > (int)array->framebuffer.width)
+        width = (int)array->framebuffer.width - x;
+    if(y + height > (int)array->framebuffer.height)
+        height = (int)array->framebuffer.height - y;
+    if(width <= 0 || height <= 0)
+        return;
+
+    matrix_array_add_dirty_region(array, x, y, width, height);
+
+    if(array->orientation == HORIZONTAL)
+    {
+        // Every matrix display under the rectangle has the same rows dirty
+        uint8_t rows = (uint8_t)((0xFF << y) & (0xFF >> (7 - (y + height - 1))));
+        for(int index = x / 8; index <= (x + width - 1) / 8; index++)
+            matrix_array_mark_display_dirty(array, index, rows);
+    }
+    else
+    {
+        // The rows of the rectangle are spread over the matrix displays below each other
+        for(int index = y / 8; index <= (y + height - 1) / 8; index++)
+        {
+            int first_row = (y > index * 8) ? y - index * 8 : 0;
+            int last_row = (y + height - 1 < index * 8 + 7) ? y + height - 1 - index * 8 : 7;
+            matrix_array_mark_display_dirty(array, index, (uint8_t)((0xFF << first_row) & (0xFF >> (7 - last_row))));
+        }
     }
 }
\ No newline at end of file
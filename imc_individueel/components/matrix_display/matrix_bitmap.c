@@ -0,0 +1,323 @@
+/*
+    Author: Kenley Strik
+    Addition: This whole file was written by Kenley Strik
+*/
+
+#include "include/matrix_bitmap.h"
+
+// Allocates a cleared bitmap of [width] x [height] pixels, returns false if there was not enough memory
+bool matrix_bitmap_init(matrix_bitmap_t* bitmap, unsigned int width, unsigned int height)
+{
+    bitmap->width = width;
+    bitmap->height = height;
+    bitmap->stride = (width + 7) / 8;                                           // Round the row up to whole bytes
+    bitmap->data = (uint8_t*)calloc(matrix_bitmap_get_word_count(bitmap), sizeof(uint32_t));   // Allocate memory for all the rows with every pixel off
+
+    return bitmap->data != NULL || bitmap->stride * height == 0;
+}
+
+// Releases the memory of the bitmap
+void matrix_bitmap_deinit(matrix_bitmap_t* bitmap)
+{
+    free(bitmap->data);     // Free memory of the rows
+    bitmap->data = NULL;
+    bitmap->width = 0;
+    bitmap->height = 0;
+    bitmap->stride = 0;
+}
+
+// Returns the number of 32-bit words the data of the bitmap is made of
+unsigned int matrix_bitmap_get_word_count(const matrix_bitmap_t* bitmap)
+{
+    return (bitmap->stride * bitmap->height + 3) / 4;
+}
+
+// Sets the value (on/off : 1/0) of the pixel at a certain x and y position, positions outside the bitmap are ignored
+void matrix_bitmap_set_pixel(matrix_bitmap_t* bitmap, int x, int y, bool is_on)
+{
+    // Check if x and y values are not outside the bitmap
+    if(x < 0 || y < 0 || x >= (int)bitmap->width || y >= (int)bitmap->height)
+        return;
+
+    uint8_t* byte = &bitmap->data[y * bitmap->stride + (x >> 3)];
+    if(is_on)
+        *byte |= (uint8_t)(1 << (x & 7));
+    else
+        *byte &= (uint8_t)~(1 << (x & 7));
+}
+
+// Returns the value (on/off : 1/0) of the pixel at a certain x and y position, positions outside the bitmap are off
+bool matrix_bitmap_get_pixel(const matrix_bitmap_t* bitmap, int x, int y)
+{
+    // Check if x and y values are not outside the bitmap
+    if(x < 0 || y < 0 || x >= (int)bitmap->width || y >= (int)bitmap->height)
+        return false;
+
+    return (bitmap->data[y * bitmap->stride + (x >> 3)] >> (x & 7)) & 1;
+}
+
+// Returns [width] (at most 32) pixels of row [y] starting at [x] packed in a mask where bit n is the pixel at x + n, pixels outside the bitmap are off
+uint32_t matrix_bitmap_get_bits(const matrix_bitmap_t* bitmap, int x, int y, int width)
+{
+    if(width > 32)
+        width = 32;
+
+    // Clip the span to the bitmap, pixels left of the bitmap are shifted back in as off at the end
+    int offset = 0;
+    if(x < 0)
+    {
+        offset = -x;
+        width += x;
+        x = 0;
+    }
+    if(x + width > (int)bitmap->width)
+        width = (int)bitmap->width - x;
+    if(y < 0 || y >= (int)bitmap->height || width <= 0)
+        return 0;
+
+    // Gather the (at most 5) bytes under the span and shift the first pixel to bit 0
+    const uint8_t* row = &bitmap->data[y * bitmap->stride];
+    uint64_t bits = 0;
+    for(int i = (x + width - 1) >> 3; i >= (x >> 3); i--)
+        bits = (bits << 8) | row[i];
+    bits >>= (x & 7);
+    bits &= ((uint64_t)1 << width) - 1;
+
+    return (uint32_t)(bits << offset);
+}
+
+// Sets [width] (at most 32) pixels of row [y] starting at [x] to the bits of [bits] where bit n is the pixel at x + n, pixels outside the bitmap are ignored
+void matrix_bitmap_set_bits(matrix_bitmap_t* bitmap, int x, int y, int width, uint32_t bits)
+{
+    if(width > 32)
+        width = 32;
+
+    // Clip the span to the bitmap, pixels left of the bitmap are shifted out of the bits
+    if(x < 0)
+    {
+        if(-x >= width)
+            return;
+        bits >>= -x;
+        width += x;
+        x = 0;
+    }
+    if(x + width > (int)bitmap->width)
+        width = (int)bitmap->width - x;
+    if(y < 0 || y >= (int)bitmap->height || width <= 0)
+        return;
+
+    // Spread the bits over the (at most 5) bytes under the span and only change the pixels of the span
+    uint8_t* row = &bitmap->data[y * bitmap->stride];
+    uint64_t mask = (((uint64_t)1 << width) - 1) << (x & 7);
+    uint64_t value = ((uint64_t)bits << (x & 7)) & mask;
+    for(int i = x >> 3; i <= (x + width - 1) >> 3; i++)
+    {
+        row[i] = (uint8_t)((row[i] & ~(uint8_t)mask) | (uint8_t)value);
+        mask >>= 8;
+        value >>= 8;
+    }
+}
+
+// Stores the pixels of the rectangle at [x, y] of [width] (at most 32) x [height] pixels as one packed mask per row in [rows]
+void matrix_bitmap_get_region(const matrix_bitmap_t* bitmap, int x, int y, int width, int height, uint32_t* rows)
+{
+    for(int i = 0; i < height; i++)
+        rows[i] = matrix_bitmap_get_bits(bitmap, x, y + i, width);
+}
+
+// Checks if any pixel in the packed masks of [mask_rows] (one per row, [width] at most 32) placed at [x, y] is turned on in the bitmap
+bool matrix_bitmap_test_mask(const matrix_bitmap_t* bitmap, int x, int y, const uint32_t* mask_rows, int width, int height)
+{
+    for(int i = 0; i < height; i++)
+    {
+        // Rows without pixels in the mask do not have to be read
+        if(mask_rows[i] != 0 && (matrix_bitmap_get_bits(bitmap, x, y + i, width) & mask_rows[i]) != 0)
+            return true;
+    }
+    return false;
+}
+
+// Sets the value of [length] pixels on row [y] starting at [x], the span is clipped to the bitmap
+void matrix_bitmap_fill_span(matrix_bitmap_t* bitmap, int x, int y, int length, bool is_on)
+{
+    // Clip the span to the bitmap
+    if(x < 0)
+    {
+        length += x;
+        x = 0;
+    }
+    if(x + length > (int)bitmap->width)
+        length = (int)bitmap->width - x;
+    if(y < 0 || y >= (int)bitmap->height || length <= 0)
+        return;
+
+    uint8_t* row = &bitmap->data[y * bitmap->stride];
+    int first_byte = x >> 3;
+    int last_byte = (x + length - 1) >> 3;
+    uint8_t first_mask = (uint8_t)(0xFF << (x & 7));                    // Pixels from x to the end of the first byte
+    uint8_t last_mask = (uint8_t)(0xFF >> (7 - ((x + length - 1) & 7))); // Pixels from the start of the last byte to the end of the span
+
+    // A span inside one byte only needs the pixels that are in both masks
+    if(first_byte == last_byte)
+        first_mask &= last_mask;
+
+    if(is_on)
+        row[first_byte] |= first_mask;
+    else
+        row[first_byte] &= (uint8_t)~first_mask;
+
+    if(first_byte != last_byte)
+    {
+        // Whole bytes between the first and last byte are set at once
+        memset(&row[first_byte + 1], is_on ? 0xFF : 0x00, last_byte - first_byte - 1);
+
+        if(is_on)
+            row[last_byte] |= last_mask;
+        else
+            row[last_byte] &= (uint8_t)~last_mask;
+    }
+}
+
+// Sets the value of all the pixels in the rectangle at [x, y] of [width] x [height] pixels, the rectangle is clipped to the bitmap
+void matrix_bitmap_fill_rect(matrix_bitmap_t* bitmap, int x, int y, int width, int height, bool is_on)
+{
+    // Clip the rows of the rectangle to the bitmap, the span clips the columns
+    if(y < 0)
+    {
+        height += y;
+        y = 0;
+    }
+    if(y + height > (int)bitmap->height)
+        height = (int)bitmap->height - y;
+
+    for(int row = y; row < y + height; row++)
+        matrix_bitmap_fill_span(bitmap, x, row, width, is_on);
+}
+
+// Sets the value of [length] pixels in column [x] starting at row [y], the line is clipped to the bitmap
+void matrix_bitmap_draw_vline(matrix_bitmap_t* bitmap, int x, int y, int length, bool is_on)
+{
+    // Clip the line to the bitmap
+    if(y < 0)
+    {
+        length += y;
+        y = 0;
+    }
+    if(y + length > (int)bitmap->height)
+        length = (int)bitmap->height - y;
+    if(x < 0 || x >= (int)bitmap->width || length <= 0)
+        return;
+
+    // The pixels of the line are the same bit of the same byte in every row
+    uint8_t* byte = &bitmap->data[y * bitmap->stride + (x >> 3)];
+    uint8_t mask = (uint8_t)(1 << (x & 7));
+    for(int i = 0; i < length; i++, byte += bitmap->stride)
+    {
+        if(is_on)
+            *byte |= mask;
+        else
+            *byte &= (uint8_t)~mask;
+    }
+}
+
+// Copies the rectangle at [source_x, source_y] of [width] x [height] pixels of [source] to [x, y] of the bitmap, 32 pixels at a time
+void matrix_bitmap_copy_rect(matrix_bitmap_t* bitmap, int x, int y, const matrix_bitmap_t* source, int source_x, int source_y, int width, int height)
+{
+    for(int row = 0; row < height; row++)
+    {
+        for(int column = 0; column < width; column += 32)
+        {
+            int length = (width - column < 32) ? width - column : 32;
+            matrix_bitmap_set_bits(bitmap, x + column, y + row, length, matrix_bitmap_get_bits(source, source_x + column, source_y + row, length));
+        }
+    }
+}
+
+// Moves all the pixels of the bitmap [dx] pixels to the right and [dy] pixels down, the pixels that are shifted in are (off : 0)
+void matrix_bitmap_shift(matrix_bitmap_t* bitmap, int dx, int dy)
+{
+    int stride = (int)bitmap->stride;
+    int height = (int)bitmap->height;
+
+    // Shifting everything out of the bitmap leaves it empty
+    if(dx >= (int)bitmap->width || -dx >= (int)bitmap->width || dy >= height || -dy >= height)
+    {
+        matrix_bitmap_clear(bitmap);
+        return;
+    }
+
+    // Move whole rows up or down and clear the rows that are shifted in
+    if(dy > 0)
+    {
+        memmove(&bitmap->data[dy * stride], bitmap->data, (height - dy) * stride);
+        memset(bitmap->data, 0x00, dy * stride);
+    }
+    else if(dy < 0)
+    {
+        memmove(bitmap->data, &bitmap->data[-dy * stride], (height + dy) * stride);
+        memset(&bitmap->data[(height + dy) * stride], 0x00, -dy * stride);
+    }
+
+    matrix_bitmap_shift_rows(bitmap, 0, height, dx);
+}
+
+// Moves the pixels of [height] rows starting at row [y] [dx] pixels to the right, the pixels that are shifted in are (off : 0)
+void matrix_bitmap_shift_rows(matrix_bitmap_t* bitmap, int y, int height, int dx)
+{
+    int stride = (int)bitmap->stride;
+
+    // Clip the rows to the bitmap
+    if(y < 0)
+    {
+        height += y;
+        y = 0;
+    }
+    if(y + height > (int)bitmap->height)
+        height = (int)bitmap->height - y;
+    if(dx == 0 || height <= 0)
+        return;
+
+    // Shifting everything out of the rows leaves them empty
+    if(dx >= (int)bitmap->width || -dx >= (int)bitmap->width)
+    {
+        memset(&bitmap->data[y * stride], 0x00, height * stride);
+        return;
+    }
+
+    // Shift every row by whole bytes and the remaining bits, carrying the bits that cross a byte into the next byte
+    int byte_shift = ((dx < 0) ? -dx : dx) >> 3;
+    int bit_shift = ((dx < 0) ? -dx : dx) & 7;
+    uint8_t last_mask = (bitmap->width & 7) ? (uint8_t)((1 << (bitmap->width & 7)) - 1) : 0xFF;    // Pixels of the last byte inside the bitmap
+    for(int row_index = y; row_index < y + height; row_index++)
+    {
+        uint8_t* row = &bitmap->data[row_index * stride];
+        if(dx < 0)
+        {
+            // Pixels move to lower x, so every byte takes its bits from the bytes after it
+            for(int i = 0; i < stride; i++)
+            {
+                uint8_t low = (i + byte_shift < stride) ? row[i + byte_shift] : 0x00;
+                uint8_t high = (i + byte_shift + 1 < stride) ? row[i + byte_shift + 1] : 0x00;
+                row[i] = bit_shift ? (uint8_t)((low >> bit_shift) | (high << (8 - bit_shift))) : low;
+            }
+        }
+        else
+        {
+            // Pixels move to higher x, so every byte takes its bits from the bytes before it
+            for(int i = stride - 1; i >= 0; i--)
+            {
+                uint8_t high = (i - byte_shift >= 0) ? row[i - byte_shift] : 0x00;
+                uint8_t low = (i - byte_shift - 1 >= 0) ? row[i - byte_shift - 1] : 0x00;
+                row[i] = bit_shift ? (uint8_t)((high << bit_shift) | (low >> (8 - bit_shift))) : high;
+            }
+            row[stride - 1] &= last_mask;   // Drop the pixels that were shifted past the right edge
+        }
+    }
+}
+
+// Sets the values of all the pixels of the bitmap to (off : 0)
+void matrix_bitmap_clear(matrix_bitmap_t* bitmap)
+{
+    if(bitmap->data != NULL)
+        memset(bitmap->data, 0x00, bitmap->stride * bitmap->height);
+}
\ No newline at end of file
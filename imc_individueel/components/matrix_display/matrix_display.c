@@ -5,37 +5,106 @@
 
 #include "include/matrix_display.h"
 
+/* 
+    First LED column for some reason is the last bit (0b10000000 : 0x80) of the display RAM, so a row where the pixel at x is bit x
+    must be rotated one to the right before it is written to the display
+*/
+static inline uint8_t matrix_display_to_display_row(uint8_t row)
+{
+    return (uint8_t)((row >> 1) | (row << 7));
+}
+
+// Commands of the HT16K33, the settings are stored in the lower bits of the command byte
+static const uint8_t MATRIX_DISPLAY_SYSTEM_SETUP = 0x20;       // Bit 0 starts the oscillator
+static const uint8_t MATRIX_DISPLAY_DISPLAY_SETUP = 0x80;      // Bit 0 turns the display on, bits 1 and 2 set the blink rate
+static const uint8_t MATRIX_DISPLAY_DIMMING_SET = 0xE0;        // Bits 0 to 3 set the brightness level
+
+/*
+    Value written to the second byte of every row in the display RAM, those bytes (columns 8 to 15) are not connected to LED's,
+    the display RAM is lost when the display loses power, so a display that no longer holds this value has to be set up again
+*/
+static const uint8_t MATRIX_DISPLAY_CANARY = 0xA5;
+
+// Writes the display setup command with the remembered display on state and blink rate
+static i2c_result_t matrix_display_write_display_setup(matrix_display_t* display)
+{
+    uint8_t command = MATRIX_DISPLAY_DISPLAY_SETUP | (uint8_t)(display->blink << 1) | (display->is_display_on ? 0x01 : 0x00);
+    return i2c_driver_write_command(display->i2c_port, display->i2c_address, command);
+}
+
 // Initializes the matrix display given to the function
 void matrix_display_init(matrix_display_t* display)
 {
     // Check if matrix display is initialized and if not initialize it
     if(!display->is_initialized)
     {
-        display->buffer = (row_pair_t*)malloc(sizeof(row_pair_t) * 8);  // Allocate enough memory to the buffer for 8 rows
-        display->buffer_length = 8;                                     // Set buffer length
+        // Allocate rows for the display if it is not a view on the rows of a matrix array
+        display->owns_rows = (display->rows == NULL);
+        if(display->owns_rows)
+        {
+            display->rows = (uint8_t*)calloc(8, sizeof(uint8_t));      // Allocate enough memory for 8 rows
+            display->row_stride = 1;                                    // Set the rows to follow each other
+        }
 
-        i2c_driver_write_register8(display->i2c_address, 0x21, 0x00);   // System setup command
-        i2c_driver_write_register8(display->i2c_address, 0x81, 0x00);   // Turn on display with no blinking
-        i2c_driver_write_register8(display->i2c_address, 0xE7, 0xFF);   // Set the matrix to full brightness
+        // Start the oscillator, turn on the display with no blinking and set the brightness, the commands are remembered so only changes are written
+        display->is_standby = false;
+        display->is_display_on = true;
+        display->blink = MATRIX_DISPLAY_BLINK_OFF;
+        display->brightness = MATRIX_DISPLAY_DEFAULT_BRIGHTNESS;
+        display->is_lost = false;
+        display->is_recovered = false;
+        display->recovery_count = 0;
+        matrix_display_setup(display);
 
-        // Loop trough all rows of the matrix and turn off the corresponding LED's
+        // The display RAM was cleared by the setup, the rows are cleared to match
         for(int y = 0; y < 8; y++)
         {
-            i2c_driver_write_register8(display->i2c_address, y * 2, 0x00);
-            display->buffer[y].data = 0x00;
-            display->buffer[y].has_changed = false;
+            display->rows[y * display->row_stride] = 0x00;
+            display->sent_rows[y] = 0x00;
         }
-        display->is_initialized = true;     // Set state of display to uninitialized
+        display->dirty_rows = 0x00;
+        display->is_initialized = true;     // Set state of display to initialized
     }
 }
 
+/*
+    Writes the setup commands with the remembered settings and clears the display RAM in one burst, this is how the display is initialized
+    and how a display that lost power is set up again, returns false if the display did not respond
+*/
+bool matrix_display_setup(matrix_display_t* display)
+{
+    // Turn off all the LED's, the bytes that are not connected get the canary value the health check looks for
+    uint8_t cleared_ram[16];
+    for(int i = 0; i < 16; i++)
+        cleared_ram[i] = (i & 1) ? MATRIX_DISPLAY_CANARY : 0x00;
+
+    bool is_ok = true;
+    is_ok &= i2c_driver_write_command(display->i2c_port, display->i2c_address, MATRIX_DISPLAY_SYSTEM_SETUP | (display->is_standby ? 0x00 : 0x01)) == I2C_DRIVER_OK;
+    is_ok &= matrix_display_write_display_setup(display) == I2C_DRIVER_OK;
+    is_ok &= i2c_driver_write_command(display->i2c_port, display->i2c_address, MATRIX_DISPLAY_DIMMING_SET | display->brightness) == I2C_DRIVER_OK;
+    is_ok &= i2c_driver_write_bytes(display->i2c_port, display->i2c_address, 0x00, cleared_ram, sizeof(cleared_ram)) == I2C_DRIVER_OK;
+    return is_ok;
+}
+
+// Checks if the matrix display responds and still holds the canary value of its setup with a single one byte read, returns false if it has to be set up again
+bool matrix_display_check_health(matrix_display_t* display)
+{
+    uint8_t value = 0x00;
+    return i2c_driver_read_bytes(display->i2c_port, display->i2c_address, 0x01, &value, 1) == I2C_DRIVER_OK && value == MATRIX_DISPLAY_CANARY;
+}
+
 // Deinitializes the matrix display given to the function
 void matrix_display_deinit(matrix_display_t* display)
 {
     // Check if matrix display is initialized and if it is uninitialize it
     if(display->is_initialized)
     {
-        free(display->buffer);              // Free memory of the buffer
+        // Free memory of the rows if they are not a view on the rows of a matrix array
+        if(display->owns_rows)
+        {
+            free(display->rows);
+            display->rows = NULL;
+        }
         display->is_initialized = false;    // Set state of display to uninitialized
     }
 }
@@ -49,26 +118,12 @@ void matrix_display_set_pixel(matrix_display_t* display, uint8_t x, uint8_t y, b
         // LED matrix is 8x8 so x or y values above 7 are not allowed (values are indexed from 0 to 7)
         if(x > 7 || y > 7)
             return;
-        
-        /* 
-            First LED column for some reason is the last bit (0b10000000 : 0x80), so the value written 
-            must be shifted one less to the left if the x value is higher than 0 and must be (0b10000000 : 0x80) otherwise
-        */
-        uint8_t row_data;
+
         if(is_on)
-            row_data = ((x == 0) ? 0x80 : (1 << (x - 1))) | display->buffer[y].data;
+            display->rows[y * display->row_stride] |= (uint8_t)(1 << x);
         else
-            row_data = ((x == 0) ? 0x80 : (1 << (x - 1))) ^ display->buffer[y].data;
-
-        /* 
-            Check if the new data of the row is different than in the buffer and of it is, 
-            change the value in the buffer and set boolean value indicating a change in row data to true
-        */
-        if(display->buffer[y].data != row_data)
-        {
-            display->buffer[y].data = row_data;
-            display->buffer[y].has_changed = true;
-        }
+            display->rows[y * display->row_stride] &= (uint8_t)~(1 << x);
+        display->dirty_rows |= (uint8_t)(1 << y);     // Mark the row to be checked on the next update
     }
 }
 
@@ -78,32 +133,118 @@ void matrix_display_set_pixels(matrix_display_t* display, matrix_display_value_p
     // Check if matrix display is initialized
     if(display->is_initialized)
     {
-        // Loop trough all pixel value pairs given and set corresponding LED values in the buffer
+        uint8_t set_masks[8] = { 0 };       // Pixels to turn on for every row
+        uint8_t clear_masks[8] = { 0 };     // Pixels to turn off for every row
+
+        // Loop trough all pixel value pairs given and collect them per row, a later pair for the same pixel wins
         for(int i = 0; i < length; i++)
-            matrix_display_set_pixel(display, pixel_values[i].x, pixel_values[i].y, pixel_values[i].is_on);
+        {
+            // LED matrix is 8x8 so x or y values above 7 are not allowed (values are indexed from 0 to 7)
+            uint8_t x = pixel_values[i].x;
+            uint8_t y = pixel_values[i].y;
+            if(x > 7 || y > 7)
+                continue;
+
+            uint8_t bit = (uint8_t)(1 << x);
+            if(pixel_values[i].is_on)
+            {
+                set_masks[y] |= bit;
+                clear_masks[y] &= (uint8_t)~bit;
+            }
+            else
+            {
+                clear_masks[y] |= bit;
+                set_masks[y] &= (uint8_t)~bit;
+            }
+        }
+
+        // Apply the changes of every touched row with one masked update
+        for(int y = 0; y < 8; y++)
+        {
+            if((set_masks[y] | clear_masks[y]) != 0x00)
+            {
+                uint8_t* row = &display->rows[y * display->row_stride];
+                *row = (uint8_t)((*row & ~clear_masks[y]) | set_masks[y]);
+                display->dirty_rows |= (uint8_t)(1 << y);     // Mark the row to be checked on the next update
+            }
+        }
     }
 }
 
-// Updates the matrix display with the data in the buffer
+// Returns the value (on/off : 1/0) of a pixel on the matrix display at a certain x and y position
+bool matrix_display_get_pixel(matrix_display_t* display, uint8_t x, uint8_t y)
+{
+    // Check if matrix display is initialized, pixels outside the 8x8 matrix are off
+    if(!display->is_initialized || x > 7 || y > 7)
+        return false;
+
+    return (display->rows[y * display->row_stride] >> x) & 1;
+}
+
+// Returns the values of the pixels on row [y] of the matrix display, bit x is the pixel at x
+uint8_t matrix_display_get_row(matrix_display_t* display, uint8_t y)
+{
+    // Check if matrix display is initialized, rows outside the 8x8 matrix are off
+    if(!display->is_initialized || y > 7)
+        return 0x00;
+
+    return display->rows[y * display->row_stride];
+}
+
+// Updates the matrix display with the dirty rows that differ from what was last written to the display
 void matrix_display_update(matrix_display_t* display)
 {
-    // Check if matrix display is initialized
-    if(display->is_initialized)
+    // Check if matrix display is initialized, a display that is lost is skipped until the health check has set it up again
+    if(display->is_initialized && !display->is_lost)
     {
-     	// Loop through all the rows in the buffer
-        for(int y = 0; y < 8; y++)
+        uint8_t row_data[8];
+        uint8_t changed_rows = 0x00;
+
+     	// Loop through the dirty rows of the display, rows that were not drawn on are skipped without reading them
+        for(uint8_t dirty_rows = display->dirty_rows; dirty_rows != 0; dirty_rows &= (uint8_t)(dirty_rows - 1))
         {
+            int y = __builtin_ctz(dirty_rows);
+
             // Check if row data has changes otherwise don't bother setting the register
-            if(display->buffer[y].has_changed)
-            {
-                i2c_driver_write_register8(display->i2c_address, y * 2, display->buffer[y].data);	// Write row data to register
-                display->buffer[y].has_changed = false;		// Set the changed state to false to indicate that the display is now in the correct state
-            }
-        }   
+            row_data[y] = matrix_display_to_display_row(display->rows[y * display->row_stride]);
+            if(display->sent_rows[y] != row_data[y])
+                changed_rows |= (uint8_t)(1 << y);
+        }
+        display->dirty_rows = 0x00;     // All rows are now in the correct state
+
+        if(changed_rows == 0x00)
+            return;
+
+        int first_row = __builtin_ctz(changed_rows);
+        int last_row = 31 - __builtin_clz(changed_rows);
+        if(first_row == last_row)
+        {
+            // Write row data to register, a display that does not respond is marked as lost for the health check
+            if(i2c_driver_write_register8(display->i2c_port, display->i2c_address, first_row * 2, row_data[first_row]) != I2C_DRIVER_OK)
+                display->is_lost = true;
+            display->sent_rows[first_row] = row_data[first_row];	// Remember the row data to indicate that the display is now in the correct state
+            return;
+        }
+
+        /*
+            Write all the rows from the first to the last changed row in one burst, the display RAM holds every row in two bytes
+            of which the second one (columns 8 to 15) is not connected and keeps the canary, rows in between that did not change are written as they were sent
+        */
+        uint8_t burst[15];
+        for(int y = first_row; y <= last_row; y++)
+        {
+            if(changed_rows & (1 << y))
+                display->sent_rows[y] = row_data[y];
+            burst[(y - first_row) * 2] = display->sent_rows[y];
+            if(y != last_row)
+                burst[(y - first_row) * 2 + 1] = MATRIX_DISPLAY_CANARY;
+        }
+        if(i2c_driver_write_bytes(display->i2c_port, display->i2c_address, first_row * 2, burst, (last_row - first_row) * 2 + 1) != I2C_DRIVER_OK)
+            display->is_lost = true;
     }
 }
 
-// Sets the values of all the pixels of the matrix display given to the function to (off : 0) essentially clearing the matrix display
+// Sets the values of all the pixels of the matrix display given to the function to (off : 0), the display is cleared on the next update
 void matrix_display_clear(matrix_display_t* display)
 {
     // Check if matrix display is initialized
@@ -111,13 +252,54 @@ void matrix_display_clear(matrix_display_t* display)
     {
         // Loop trough all rows of the matrix and turn off the corresponding LED's
         for(int y = 0; y < 8; y++)
-        {
-            if(display->buffer[y].data != 0x00)
-            {
-                display->buffer[y].data = 0x00;										// Clear buffer row data
-                display->buffer[y].has_changed = false;								// Clear buffer changed state
-                i2c_driver_write_register8(display->i2c_address, y * 2, 0x00);		// Write 0 to row register to turn off LED's on the row
-            }
-        }
+            display->rows[y * display->row_stride] = 0x00;
+        display->dirty_rows = 0xFF;     // Mark all the rows to be checked on the next update
+    }
+}
+
+// Sets the brightness level (0 to MATRIX_DISPLAY_MAX_BRIGHTNESS) of the matrix display, nothing is written when the level did not change
+void matrix_display_set_brightness(matrix_display_t* display, uint8_t brightness)
+{
+    if(brightness > MATRIX_DISPLAY_MAX_BRIGHTNESS)
+        brightness = MATRIX_DISPLAY_MAX_BRIGHTNESS;
+
+    // Check if matrix display is initialized and the brightness changed
+    if(display->is_initialized && display->brightness != brightness)
+    {
+        i2c_driver_write_command(display->i2c_port, display->i2c_address, MATRIX_DISPLAY_DIMMING_SET | brightness);
+        display->brightness = brightness;
+    }
+}
+
+// Sets the blink rate of the matrix display, nothing is written when the blink rate did not change
+void matrix_display_set_blink(matrix_display_t* display, matrix_display_blink_t blink)
+{
+    // Check if matrix display is initialized and the blink rate changed
+    if(display->is_initialized && display->blink != blink)
+    {
+        display->blink = blink;
+        matrix_display_write_display_setup(display);
+    }
+}
+
+// Turns the LEDs of the matrix display on or off without changing the display RAM, nothing is written when the state did not change
+void matrix_display_set_display_on(matrix_display_t* display, bool is_on)
+{
+    // Check if matrix display is initialized and the state changed
+    if(display->is_initialized && display->is_display_on != is_on)
+    {
+        display->is_display_on = is_on;
+        matrix_display_write_display_setup(display);
+    }
+}
+
+// Stops (standby) or starts the oscillator of the matrix display, the display RAM is kept during standby, nothing is written when the state did not change
+void matrix_display_set_standby(matrix_display_t* display, bool is_standby)
+{
+    // Check if matrix display is initialized and the state changed
+    if(display->is_initialized && display->is_standby != is_standby)
+    {
+        i2c_driver_write_command(display->i2c_port, display->i2c_address, MATRIX_DISPLAY_SYSTEM_SETUP | (is_standby ? 0x00 : 0x01));
+        display->is_standby = is_standby;
     }
 }
\ No newline at end of file
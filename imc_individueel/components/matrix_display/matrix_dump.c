@@ -0,0 +1,147 @@
+/*
+    Author: Kenley Strik
+    Addition: This whole file was written by Kenley Strik
+*/
+
+#include "include/matrix_dump.h"
+
+static const uint32_t MATRIX_DUMP_HASH_OFFSET = 2166136261u;   // Offset basis of the 32 bit FNV-1a hash
+static const uint32_t MATRIX_DUMP_HASH_PRIME = 16777619u;      // Prime of the 32 bit FNV-1a hash
+
+// Writes [length] bytes with the write function of the dump, after a failed write nothing is written anymore
+static void matrix_dump_write(matrix_dump_t* dump, const uint8_t* data, size_t length)
+{
+    if(!dump->has_failed && !dump->write(dump->context, data, length))
+        dump->has_failed = true;
+}
+
+// Writes a repeat record for the frames that were the same as the last frame written
+static void matrix_dump_write_repeat(matrix_dump_t* dump)
+{
+    uint8_t record[3] = { MATRIX_DUMP_RECORD_REPEAT, (uint8_t)(dump->repeat_count & 0xFF), (uint8_t)(dump->repeat_count >> 8) };
+    matrix_dump_write(dump, record, sizeof(record));
+    dump->repeat_count = 0;
+}
+
+// Initializes the dump given to the function for the panels of the matrix array and writes the header
+bool matrix_dump_init(matrix_dump_t* dump, matrix_array_t** array, matrix_dump_write_t write, void* context)
+{
+    // Check if dump is initialized and if not initialize it
+    if(!dump->is_initialized)
+    {
+        dump->write = write;
+        dump->context = context;
+        dump->panel_count = (*array)->matrix_display_count;
+        dump->frame = (uint8_t*)calloc(dump->panel_count * 8 + 1, sizeof(uint8_t));        // One extra byte so an empty array still gets a buffer
+        dump->last_frame = (uint8_t*)calloc(dump->panel_count * 8 + 1, sizeof(uint8_t));
+        if(dump->frame == NULL || dump->last_frame == NULL)
+        {
+            free(dump->frame);
+            free(dump->last_frame);
+            return false;
+        }
+        dump->repeat_count = 0;
+        dump->frame_count = 0;
+        dump->last_hash = 0;
+        dump->has_frame = false;
+        dump->has_failed = false;
+
+        // Header with the size and layout of the panels, so a reader can place the panels without the matrix array
+        uint16_t width = (uint16_t)(*array)->framebuffer.width;
+        uint16_t height = (uint16_t)(*array)->framebuffer.height;
+        uint8_t header[MATRIX_DUMP_HEADER_SIZE] = { 0 };
+        memcpy(header, MATRIX_DUMP_MAGIC, 4);
+        header[4] = MATRIX_DUMP_VERSION;
+        header[5] = (uint8_t)(*array)->orientation;
+        header[6] = (uint8_t)(dump->panel_count & 0xFF);
+        header[7] = (uint8_t)(dump->panel_count >> 8);
+        header[8] = (uint8_t)(width & 0xFF);
+        header[9] = (uint8_t)(width >> 8);
+        header[10] = (uint8_t)(height & 0xFF);
+        header[11] = (uint8_t)(height >> 8);
+        matrix_dump_write(dump, header, MATRIX_DUMP_HEADER_SIZE);
+        if(dump->has_failed)
+        {
+            free(dump->frame);
+            free(dump->last_frame);
+            return false;
+        }
+
+        dump->is_initialized = true;
+    }
+    return true;
+}
+
+// Writes the repeat count that is not written yet and deinitializes the dump given to the function
+void matrix_dump_deinit(matrix_dump_t* dump)
+{
+    // Check if dump is initialized
+    if(dump->is_initialized)
+    {
+        if(dump->repeat_count > 0)
+            matrix_dump_write_repeat(dump);
+
+        free(dump->frame);
+        free(dump->last_frame);
+        dump->is_initialized = false;
+    }
+}
+
+// Captures the rows all the panels of the matrix array show as the next frame, returns the hash of the frame
+uint32_t matrix_dump_capture(matrix_dump_t* dump, matrix_array_t** array)
+{
+    // Check if dump is initialized, panels added after the dump was initialized are not part of the frames
+    if(!dump->is_initialized)
+        return 0;
+
+    for(int i = 0; i < dump->panel_count && i < (*array)->matrix_display_count; i++)
+    {
+        for(uint8_t y = 0; y < 8; y++)
+            dump->frame[i * 8 + y] = matrix_display_get_row(&(*array)->matrix_displays[i], y);
+    }
+    return matrix_dump_capture_rows(dump, dump->frame);
+}
+
+// Captures [rows] (8 bytes per panel) as the next frame, a frame that did not change is only counted
+uint32_t matrix_dump_capture_rows(matrix_dump_t* dump, const uint8_t* rows)
+{
+    // Check if dump is initialized
+    if(!dump->is_initialized)
+        return 0;
+
+    size_t frame_size = dump->panel_count * 8;
+    dump->frame_count++;
+    if(dump->has_frame && memcmp(rows, dump->last_frame, frame_size) == 0)
+    {
+        // Unchanged frames only cost a repeat record, which is written when the frame changes or the count is full
+        if(++dump->repeat_count == MATRIX_DUMP_MAX_REPEAT)
+            matrix_dump_write_repeat(dump);
+        return dump->last_hash;
+    }
+
+    if(dump->repeat_count > 0)
+        matrix_dump_write_repeat(dump);
+
+    dump->last_hash = matrix_dump_hash(rows, frame_size);
+    uint8_t tag = MATRIX_DUMP_RECORD_FRAME;
+    uint8_t hash[4] = { (uint8_t)(dump->last_hash & 0xFF), (uint8_t)(dump->last_hash >> 8), (uint8_t)(dump->last_hash >> 16), (uint8_t)(dump->last_hash >> 24) };
+    matrix_dump_write(dump, &tag, 1);
+    matrix_dump_write(dump, rows, frame_size);
+    matrix_dump_write(dump, hash, sizeof(hash));
+
+    memmove(dump->last_frame, rows, frame_size);       // The rows may be the frame buffer of the dump itself
+    dump->has_frame = true;
+    return dump->last_hash;
+}
+
+// Returns the FNV-1a hash of [length] bytes at [data]
+uint32_t matrix_dump_hash(const uint8_t* data, size_t length)
+{
+    uint32_t hash = MATRIX_DUMP_HASH_OFFSET;
+    for(size_t i = 0; i < length; i++)
+    {
+        hash ^= data[i];
+        hash *= MATRIX_DUMP_HASH_PRIME;
+    }
+    return hash;
+}
\ No newline at end of file
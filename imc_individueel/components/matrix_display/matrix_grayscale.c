@@ -0,0 +1,317 @@
+/*
+    Author: Kenley Strik
+    Addition: This whole file was written by Kenley Strik
+*/
+
+#include "include/matrix_grayscale.h"
+
+static const uint32_t MATRIX_GRAYSCALE_TASK_STACK_SIZE = 2048;
+static const UBaseType_t MATRIX_GRAYSCALE_TASK_PRIORITY = 5;
+
+void matrix_grayscale_choose_order(matrix_grayscale_t* grayscale);
+void matrix_grayscale_hold_timer_callback(void* arg);
+void matrix_grayscale_refresh_task(void* pvParameter);
+
+// Initializes the grayscale mode given to the function with [plane_count] (2 to 4) bitplanes the size of the matrix array, returns false if there was not enough memory
+bool matrix_grayscale_init(matrix_grayscale_t* grayscale, matrix_array_t** array, unsigned int plane_count)
+{
+    // Check if grayscale mode is initialized and if not initialize it
+    if(!grayscale->is_initialized)
+    {
+        // Check if matrix array is initialized, its framebuffer sets the size of the bitplanes
+        if(!(*array)->is_initialized)
+            return false;
+
+        if(plane_count < MATRIX_GRAYSCALE_MIN_PLANES)
+            plane_count = MATRIX_GRAYSCALE_MIN_PLANES;
+        if(plane_count > MATRIX_GRAYSCALE_MAX_PLANES)
+            plane_count = MATRIX_GRAYSCALE_MAX_PLANES;
+
+        grayscale->array = *array;
+        grayscale->plane_count = plane_count;
+        grayscale->is_initialized = true;      // Set initialized so a failed allocation can be undone by the deinitialization
+
+        // Allocate the drawn, presented and shown bitplanes
+        bool has_memory = true;
+        for(int i = 0; i < MATRIX_GRAYSCALE_MAX_PLANES; i++)
+        {
+            grayscale->planes[i] = grayscale->presented_planes[i] = grayscale->shown_planes[i] = (matrix_bitmap_t){ NULL, 0, 0, 0 };
+            if(i < plane_count)
+            {
+                unsigned int width = (*array)->framebuffer.width;
+                unsigned int height = (*array)->framebuffer.height;
+                has_memory &= matrix_bitmap_init(&grayscale->planes[i], width, height);
+                has_memory &= matrix_bitmap_init(&grayscale->presented_planes[i], width, height);
+                has_memory &= matrix_bitmap_init(&grayscale->shown_planes[i], width, height);
+            }
+            grayscale->plane_order[i] = i;
+        }
+
+        grayscale->frame_mutex = xSemaphoreCreateMutex();
+        grayscale->stopped_semaphore = xSemaphoreCreateBinary();
+        grayscale->has_new_frame = false;
+        grayscale->task_handle = NULL;
+        grayscale->is_stopping = false;
+        grayscale->is_running = false;
+        grayscale->cycle_count = 0;
+        grayscale->refresh_rate = 0.0f;
+
+        // Create the timer that ends the time a bitplane is shown
+        esp_timer_create_args_t timer_args = {
+            .callback = &matrix_grayscale_hold_timer_callback,
+            .arg = grayscale,
+            .name = "matrix_grayscale_hold"
+        };
+        grayscale->hold_timer = NULL;
+        if(esp_timer_create(&timer_args, &grayscale->hold_timer) != ESP_OK)
+            has_memory = false;
+
+        if(!has_memory)
+        {
+            matrix_grayscale_deinit(grayscale);
+            return false;
+        }
+    }
+    return true;
+}
+
+// Deinitializes the grayscale mode given to the function, the refresh task is stopped first
+void matrix_grayscale_deinit(matrix_grayscale_t* grayscale)
+{
+    // Check if grayscale mode is initialized
+    if(grayscale->is_initialized)
+    {
+        matrix_grayscale_stop(grayscale);
+
+        // Free the memory of the bitplanes
+        for(int i = 0; i < MATRIX_GRAYSCALE_MAX_PLANES; i++)
+        {
+            matrix_bitmap_deinit(&grayscale->planes[i]);
+            matrix_bitmap_deinit(&grayscale->presented_planes[i]);
+            matrix_bitmap_deinit(&grayscale->shown_planes[i]);
+        }
+
+        if(grayscale->hold_timer != NULL)
+            esp_timer_delete(grayscale->hold_timer);
+        vSemaphoreDelete(grayscale->frame_mutex);
+        vSemaphoreDelete(grayscale->stopped_semaphore);
+        grayscale->is_initialized = false;
+    }
+}
+
+// Starts the refresh task pinned to core [core_id] (or tskNO_AFFINITY) that takes over the matrix displays, bitplane 0 is shown for [base_period] microseconds
+void matrix_grayscale_start(matrix_grayscale_t* grayscale, unsigned int base_period, BaseType_t core_id)
+{
+    // Check if grayscale mode is initialized and the refresh task is not running yet
+    if(grayscale->is_initialized && !grayscale->is_running)
+    {
+        grayscale->base_period = (base_period > 0) ? base_period : 1;
+        grayscale->is_stopping = false;
+        grayscale->is_running = true;
+        grayscale->array->is_grayscale = true;     // The refresh task updates the matrix displays from now on
+
+        // Create refresh task for cycling through the bitplanes
+        if(xTaskCreatePinnedToCore(&matrix_grayscale_refresh_task, "matrix_grayscale", MATRIX_GRAYSCALE_TASK_STACK_SIZE,
+                grayscale, MATRIX_GRAYSCALE_TASK_PRIORITY, &grayscale->task_handle, core_id) != pdPASS)
+        {
+            grayscale->task_handle = NULL;
+            grayscale->is_running = false;
+            grayscale->array->is_grayscale = false;
+        }
+    }
+}
+
+// Stops the refresh task and gives the matrix displays back to the framebuffer of the matrix array
+void matrix_grayscale_stop(matrix_grayscale_t* grayscale)
+{
+    // Check if grayscale mode is initialized and the refresh task is running
+    if(grayscale->is_initialized && grayscale->is_running)
+    {
+        // The refresh task stops after the bitplane it is showing, at most the time of the last bitplane
+        grayscale->is_stopping = true;
+        xSemaphoreTake(grayscale->stopped_semaphore, portMAX_DELAY);
+        grayscale->task_handle = NULL;
+        grayscale->is_running = false;
+
+        // Show the framebuffer again on the next update
+        matrix_array_bind_displays(&grayscale->array, &grayscale->array->framebuffer);
+        grayscale->array->is_grayscale = false;
+    }
+}
+
+// Sets the level (0 to 2^plane_count - 1) of the pixel at a certain x and y position
+void matrix_grayscale_set_pixel(matrix_grayscale_t* grayscale, int x, int y, uint8_t level)
+{
+    // Check if grayscale mode is initialized, bit n of the level is stored in bitplane n
+    if(grayscale->is_initialized)
+    {
+        for(int i = 0; i < grayscale->plane_count; i++)
+            matrix_bitmap_set_pixel(&grayscale->planes[i], x, y, (level >> i) & 1);
+    }
+}
+
+// Returns the level of the pixel at a certain x and y position, pixels outside the matrix array are 0
+uint8_t matrix_grayscale_get_pixel(matrix_grayscale_t* grayscale, int x, int y)
+{
+    uint8_t level = 0;
+
+    // Check if grayscale mode is initialized
+    if(grayscale->is_initialized)
+    {
+        for(int i = 0; i < grayscale->plane_count; i++)
+            level |= (uint8_t)(matrix_bitmap_get_pixel(&grayscale->planes[i], x, y) << i);
+    }
+    return level;
+}
+
+// Sets the level of all the pixels in the rectangle at [x, y] of [width] x [height] pixels
+void matrix_grayscale_fill_rect(matrix_grayscale_t* grayscale, int x, int y, int width, int height, uint8_t level)
+{
+    // Check if grayscale mode is initialized
+    if(grayscale->is_initialized)
+    {
+        for(int i = 0; i < grayscale->plane_count; i++)
+            matrix_bitmap_fill_rect(&grayscale->planes[i], x, y, width, height, (level >> i) & 1);
+    }
+}
+
+// Sets the level of all the pixels to 0
+void matrix_grayscale_clear(matrix_grayscale_t* grayscale)
+{
+    // Check if grayscale mode is initialized
+    if(grayscale->is_initialized)
+    {
+        for(int i = 0; i < grayscale->plane_count; i++)
+            matrix_bitmap_clear(&grayscale->planes[i]);
+    }
+}
+
+// Hands the drawn bitplanes to the refresh task, which shows them from its next cycle on
+void matrix_grayscale_present(matrix_grayscale_t* grayscale)
+{
+    // Check if grayscale mode is initialized
+    if(grayscale->is_initialized)
+    {
+        // Copy the bitplanes so drawing the next frame does not change what the refresh task picks up
+        xSemaphoreTake(grayscale->frame_mutex, portMAX_DELAY);
+        for(int i = 0; i < grayscale->plane_count; i++)
+            memcpy(grayscale->presented_planes[i].data, grayscale->planes[i].data, grayscale->planes[i].stride * grayscale->planes[i].height);
+        grayscale->has_new_frame = true;
+        xSemaphoreGive(grayscale->frame_mutex);
+    }
+}
+
+// Searches the order of the bitplanes after the first [depth] ones in [order] for which the fewest bytes change during a whole cycle
+static void matrix_grayscale_search_order(unsigned int costs[][MATRIX_GRAYSCALE_MAX_PLANES], unsigned int count, uint8_t* order,
+        unsigned int depth, unsigned int cost, uint8_t* best_order, unsigned int* best_cost)
+{
+    // A whole order also pays for going from the last bitplane back to the first one of the next cycle
+    if(depth == count)
+    {
+        cost += costs[order[count - 1]][order[0]];
+        if(cost < *best_cost)
+        {
+            *best_cost = cost;
+            memcpy(best_order, order, count);
+        }
+        return;
+    }
+
+    for(uint8_t plane = 1; plane < count; plane++)
+    {
+        bool is_used = false;
+        for(int i = 0; i < depth; i++)
+            is_used |= (order[i] == plane);
+        if(is_used)
+            continue;
+
+        order[depth] = plane;
+        matrix_grayscale_search_order(costs, count, order, depth + 1, cost + costs[order[depth - 1]][plane], best_order, best_cost);
+    }
+}
+
+/*
+    Chooses the order the refresh task shows the bitplanes in, every change between two bitplanes is a byte that has to be written,
+    so the order (the cycle starting at bitplane 0, at most 3! orders for 4 bitplanes) with the fewest changed bytes is used
+*/
+void matrix_grayscale_choose_order(matrix_grayscale_t* grayscale)
+{
+    unsigned int count = grayscale->plane_count;
+    unsigned int size = grayscale->shown_planes[0].stride * grayscale->shown_planes[0].height;
+
+    // Count the bytes that differ between every two bitplanes
+    unsigned int costs[MATRIX_GRAYSCALE_MAX_PLANES][MATRIX_GRAYSCALE_MAX_PLANES] = { { 0 } };
+    for(int a = 0; a < count; a++)
+    {
+        for(int b = a + 1; b < count; b++)
+        {
+            for(unsigned int i = 0; i < size; i++)
+                costs[a][b] += (grayscale->shown_planes[a].data[i] != grayscale->shown_planes[b].data[i]);
+            costs[b][a] = costs[a][b];
+        }
+    }
+
+    uint8_t order[MATRIX_GRAYSCALE_MAX_PLANES] = { 0 };
+    unsigned int best_cost = UINT32_MAX;
+    matrix_grayscale_search_order(costs, count, order, 1, 0, grayscale->plane_order, &best_cost);
+}
+
+// Callback function for the hold timer waking the refresh task when the bitplane it shows was shown long enough
+void matrix_grayscale_hold_timer_callback(void* arg)
+{
+    matrix_grayscale_t* grayscale = (matrix_grayscale_t*)arg;
+    xTaskNotifyGive(grayscale->task_handle);
+}
+
+// Function for the refresh task that shows every bitplane for its share of the cycle, so a pixel is lit for a time that matches its level
+void matrix_grayscale_refresh_task(void* pvParameter)
+{
+    // Cast void pointer that was passed to the task as parameter to the corresponding grayscale mode
+    matrix_grayscale_t* grayscale = (matrix_grayscale_t*)pvParameter;
+    matrix_array_t* array = grayscale->array;
+    grayscale->task_handle = xTaskGetCurrentTaskHandle();  // The hold timer may need the handle before xTaskCreatePinnedToCore returns
+    grayscale->rate_window_start = esp_timer_get_time();
+    grayscale->rate_window_cycles = 0;
+
+    while(!grayscale->is_stopping)
+    {
+        // Pick up a presented frame at the start of a cycle and choose the order of its bitplanes
+        xSemaphoreTake(grayscale->frame_mutex, portMAX_DELAY);
+        bool has_new_frame = grayscale->has_new_frame;
+        if(has_new_frame)
+        {
+            for(int i = 0; i < grayscale->plane_count; i++)
+                memcpy(grayscale->shown_planes[i].data, grayscale->presented_planes[i].data, grayscale->planes[i].stride * grayscale->planes[i].height);
+            grayscale->has_new_frame = false;
+        }
+        xSemaphoreGive(grayscale->frame_mutex);
+        if(has_new_frame)
+            matrix_grayscale_choose_order(grayscale);
+
+        // Show every bitplane, only the rows that differ from the previous bitplane are written in one burst per matrix display
+        for(int i = 0; i < grayscale->plane_count && !grayscale->is_stopping; i++)
+        {
+            int plane = grayscale->plane_order[i];
+            matrix_array_bind_displays(&array, &grayscale->shown_planes[plane]);
+            matrix_array_flush(&array);
+
+            // Keep the bitplane on the matrix displays for its weight
+            esp_timer_start_once(grayscale->hold_timer, grayscale->base_period << plane);
+            ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
+        }
+
+        // Calculate the achieved refresh rate once every second
+        grayscale->cycle_count++;
+        grayscale->rate_window_cycles++;
+        int64_t now = esp_timer_get_time();
+        if(now - grayscale->rate_window_start >= 1000000)
+        {
+            grayscale->refresh_rate = (float)grayscale->rate_window_cycles * 1000000.0f / (float)(now - grayscale->rate_window_start);
+            grayscale->rate_window_start = now;
+            grayscale->rate_window_cycles = 0;
+        }
+    }
+
+    xSemaphoreGive(grayscale->stopped_semaphore);  // Report the refresh task has stopped
+    vTaskDelete(NULL);  // Delete the task, it is not needed anymore
+}
\ No newline at end of file
@@ -0,0 +1,35 @@
+/*
+    Author: Kenley Strik
+    Addition: This whole file was written by Kenley Strik
+*/
+
+#ifndef MATRIX_FONT_H
+#define MATRIX_FONT_H
+
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*
+    Type for representing a fixed size 1-bit font, every glyph is stored as [width] bytes (one per column) with the pixel
+    on row n in bit n, the tables are generated from the descriptions in fonts/ by tools/generate_font.py when building
+*/
+typedef struct
+{
+    const uint8_t* columns;     // Columns of all the glyphs from [first_char] to [last_char] after each other
+    uint8_t first_char;         // Character of the first glyph in the table
+    uint8_t last_char;          // Character of the last glyph in the table
+    uint8_t width;              // Width of every glyph in pixels, without the column of spacing between glyphs
+    uint8_t height;             // Height of every glyph in pixels, at most 8
+} matrix_font_t;
+
+extern const matrix_font_t matrix_font_5x7;     // Font of 5 x 7 pixels, fills one matrix display
+extern const matrix_font_t matrix_font_3x5;     // Font of 3 x 5 pixels, fits two characters on one matrix display
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif  // MATRIX_FONT_H
\ No newline at end of file
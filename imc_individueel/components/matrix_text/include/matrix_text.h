@@ -0,0 +1,47 @@
+/*
+    Author: Kenley Strik
+    Addition: This whole file was written by Kenley Strik
+*/
+
+#ifndef MATRIX_TEXT_H
+#define MATRIX_TEXT_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <string.h>
+
+#include "matrix_array.h"
+#include "matrix_font.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// Type for representing a marquee that scrolls a text from right to left across rows of a matrix array one column per step
+typedef struct
+{
+    const matrix_font_t* font;      // Font the text is shown in
+    const char* text;               // Text that is scrolled, it is not copied and has to stay valid while the marquee is used
+    unsigned int length;            // Ammount of characters in the text
+    int y;                          // Top row of the marquee on the matrix array
+    unsigned int char_index;        // Index of the character of which the next column is appended, [length] while the gap is appended
+    unsigned int column_index;      // Column of the character that is appended next, the column after the glyph is the spacing
+    unsigned int gap_columns;       // Ammount of empty columns appended after the text, the text starts again after a whole array width
+    bool is_initialized;            // Boolean value for indicating if the marquee is initialized
+} matrix_text_marquee_t;
+
+// Returns the width in pixels of [text] shown in [font], including the spacing between the characters
+int matrix_text_get_width(const matrix_font_t* font, const char* text);
+// Draws [text] in [font] with its top left corner at [x, y] on the selected layer of the matrix array, returns the x position after the text
+int matrix_text_draw_string(matrix_array_t** array, const matrix_font_t* font, int x, int y, const char* text);
+
+// Initializes the marquee given to the function for scrolling [text] in [font] across the rows starting at [y]
+void matrix_text_marquee_init(matrix_text_marquee_t* marquee, const matrix_font_t* font, const char* text, int y);
+// Shifts the rows of the marquee one pixel to the left and appends the next column of the text on the right edge of the matrix array
+void matrix_text_marquee_step(matrix_text_marquee_t* marquee, matrix_array_t** array);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif  // MATRIX_TEXT_H
\ No newline at end of file
@@ -0,0 +1,122 @@
+/*
+    Author: Kenley Strik
+    Addition: This whole file was written by Kenley Strik
+*/
+
+#include "include/matrix_text.h"
+
+// Returns the column of the glyph of [character] at [column], characters that are not in the font are shown as spaces
+static inline uint8_t matrix_text_get_glyph_column(const matrix_font_t* font, unsigned char character, unsigned int column)
+{
+    if(column >= font->width || character < font->first_char || character > font->last_char)
+        return 0x00;    // Spacing between glyphs or unknown character
+    return font->columns[(character - font->first_char) * font->width + column];
+}
+
+// Returns the width of the bitmap the drawing functions of the matrix array use, this is the canvas when it is selected
+static inline int matrix_text_get_target_width(matrix_array_t* array)
+{
+    return (array->draw_layer == MATRIX_ARRAY_CANVAS) ? (int)array->canvas.width : (int)array->framebuffer.width;
+}
+
+// Returns the width in pixels of [text] shown in [font], including the spacing between the characters
+int matrix_text_get_width(const matrix_font_t* font, const char* text)
+{
+    int length = strlen(text);
+    return (length > 0) ? length * (font->width + 1) - 1 : 0;
+}
+
+// Draws [text] in [font] with its top left corner at [x, y] on the selected layer of the matrix array, returns the x position after the text
+int matrix_text_draw_string(matrix_array_t** array, const matrix_font_t* font, int x, int y, const char* text)
+{
+    int width = matrix_text_get_width(font, text);
+
+    // Check if matrix array is inititialied
+    if(!(*array)->is_initialized)
+        return x + width;
+
+    int target_width = matrix_text_get_target_width(*array);
+    unsigned int char_index = 0;
+    unsigned int column_index = 0;
+
+    // Turn the glyph columns into rows of at most 32 pixels so every row of the text is set with one call per 32 pixels
+    for(int chunk = 0; chunk < width; chunk += 32)
+    {
+        int length = (width - chunk < 32) ? width - chunk : 32;
+        uint32_t rows[8] = { 0 };
+        for(int column = 0; column < length; column++)
+        {
+            // Move every bit of the column to the row it belongs to
+            uint8_t bits = matrix_text_get_glyph_column(font, (unsigned char)text[char_index], column_index);
+            for(int row = 0; bits != 0; row++, bits >>= 1)
+                rows[row] |= (uint32_t)(bits & 1) << column;
+
+            if(++column_index > font->width)
+            {
+                column_index = 0;
+                char_index++;
+            }
+        }
+
+        // Rows of chunks that are not on the array do not have to be set
+        if(x + chunk + length <= 0 || x + chunk >= target_width)
+            continue;
+        for(int row = 0; row < font->height; row++)
+            matrix_array_set_row_bits(array, x + chunk, y + row, length, rows[row]);
+    }
+
+    return x + width;
+}
+
+// Initializes the marquee given to the function for scrolling [text] in [font] across the rows starting at [y]
+void matrix_text_marquee_init(matrix_text_marquee_t* marquee, const matrix_font_t* font, const char* text, int y)
+{
+    // Check if marquee is initialized and if not initialize it
+    if(!marquee->is_initialized)
+    {
+        marquee->font = font;
+        marquee->text = text;
+        marquee->length = strlen(text);
+        marquee->y = y;
+        marquee->char_index = 0;        // Start with the first column of the first character
+        marquee->column_index = 0;
+        marquee->gap_columns = 0;
+        marquee->is_initialized = true;
+    }
+}
+
+// Shifts the rows of the marquee one pixel to the left and appends the next column of the text on the right edge of the matrix array
+void matrix_text_marquee_step(matrix_text_marquee_t* marquee, matrix_array_t** array)
+{
+    // Check if marquee and matrix array are initialized
+    if(!marquee->is_initialized || !(*array)->is_initialized)
+        return;
+
+    const matrix_font_t* font = marquee->font;
+    int target_width = matrix_text_get_target_width(*array);
+
+    // One shift per row moves everything that is shown already
+    matrix_array_shift_rows(array, marquee->y, font->height, -1);
+
+    // Append the next column of the text, the gap after the text is empty
+    uint8_t bits = 0x00;
+    if(marquee->char_index < marquee->length)
+        bits = matrix_text_get_glyph_column(font, (unsigned char)marquee->text[marquee->char_index], marquee->column_index);
+    for(int row = 0; row < font->height; row++)
+        matrix_array_set_row_bits(array, target_width - 1, marquee->y + row, 1, (bits >> row) & 1);
+
+    // Advance to the next column, after the gap of one array width the text starts again
+    if(marquee->char_index < marquee->length)
+    {
+        if(++marquee->column_index > font->width)
+        {
+            marquee->column_index = 0;
+            marquee->char_index++;
+        }
+    }
+    else if(++marquee->gap_columns >= (unsigned int)target_width)
+    {
+        marquee->gap_columns = 0;
+        marquee->char_index = 0;
+    }
+}
\ No newline at end of file
@@ -0,0 +1,99 @@
+#!/usr/bin/env python3
+"""
+    Author: Kenley Strik
+    Addition: This whole file was written by Kenley Strik
+
+    Generates the C source of a matrix font from a font description in fonts/, every glyph is stored as one byte
+    per column where bit n is the pixel on row n, so the text renderer never has to look at single pixels
+"""
+
+import argparse
+import sys
+
+FIRST_CHAR = 32     # Space
+LAST_CHAR = 126     # Tilde
+
+
+def parse_font(path):
+    """Reads the width, height and glyphs (character to list of rows) of a font description"""
+    width = height = None
+    glyphs = {}
+    character = None
+    with open(path) as file:
+        for number, line in enumerate(file, 1):
+            line = line.rstrip("\n")
+            if (line.startswith("#") and character is None) or not line.strip():
+                character = None    # A blank line or comment ends the rows of a glyph
+                continue
+            words = line.split()
+            if words[0] == "width":
+                width = int(words[1])
+            elif words[0] == "height":
+                height = int(words[1])
+            elif words[0] == "glyph":
+                character = " " if words[1] == "space" else words[1]
+                if len(character) != 1 or not FIRST_CHAR <= ord(character) <= LAST_CHAR:
+                    sys.exit("%s:%d: glyph must be one printable character or 'space'" % (path, number))
+                glyphs[character] = []
+            elif character is not None:
+                if len(line) != width or any(pixel not in ".#" for pixel in line):
+                    sys.exit("%s:%d: row must be %d pixels of '.' or '#'" % (path, number, width))
+                glyphs[character].append(line)
+            else:
+                sys.exit("%s:%d: unexpected line" % (path, number))
+
+    if width is None or height is None or not 1 <= height <= 8:
+        sys.exit("%s: font needs a width and a height of 1 to 8 pixels" % path)
+    for character, rows in glyphs.items():
+        if len(rows) != height:
+            sys.exit("%s: glyph '%s' must have %d rows" % (path, character, height))
+    return width, height, glyphs
+
+
+def glyph_columns(rows, width):
+    """Packs the rows of a glyph into one byte per column with the top row in bit 0"""
+    columns = []
+    for x in range(width):
+        column = 0
+        for y, row in enumerate(rows):
+            if row[x] == "#":
+                column |= 1 << y
+        columns.append(column)
+    return columns
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__)
+    parser.add_argument("font", help="font description to read")
+    parser.add_argument("output", help="C source file to write")
+    parser.add_argument("name", help="name of the matrix_font_t in the C source")
+    args = parser.parse_args()
+
+    width, height, glyphs = parse_font(args.font)
+    lines = [
+        "/*",
+        "    Generated by generate_font.py from %s, do not edit" % args.font.replace("\\", "/").split("/")[-1],
+        "*/",
+        "",
+        '#include "matrix_font.h"',
+        "",
+        "// Columns of the glyphs from '%c' to '%c', %d bytes per glyph with the top row in bit 0" % (FIRST_CHAR, LAST_CHAR, width),
+        "static const uint8_t %s_columns[] = {" % args.name,
+    ]
+    for code in range(FIRST_CHAR, LAST_CHAR + 1):
+        character = chr(code)
+        rows = glyphs.get(character) or glyphs.get(character.upper()) or ["." * width] * height
+        columns = ", ".join("0x%02X" % column for column in glyph_columns(rows, width))
+        lines.append("    %s,%s// %s" % (columns, " " * 4, repr(character)))
+    lines += [
+        "};",
+        "",
+        "const matrix_font_t %s = { %s_columns, %d, %d, %d, %d };" % (args.name, args.name, FIRST_CHAR, LAST_CHAR, width, height),
+    ]
+
+    with open(args.output, "w") as file:
+        file.write("\n".join(lines) + "\n")
+
+
+if __name__ == "__main__":
+    main()
\ No newline at end of file
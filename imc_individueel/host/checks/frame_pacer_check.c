@@ -0,0 +1,120 @@
+/*
+    Author: Kenley Strik
+    Addition: This whole file was written by Kenley Strik
+*/
+
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "esp_timer.h"
+#include "frame_pacer.h"
+
+static const unsigned int CHECK_TARGET_FPS = 50;        // Target frame rate, one frame every 20 ms
+static const int64_t CHECK_TICK = 1000;                 // Time in microseconds between two ticks of the loop that asks for frames
+static const int64_t CHECK_DURATION = 3000000;          // Time in microseconds every scenario runs
+static const int64_t CHECK_FAST_FLUSH = 2000;           // Flush time in microseconds that fits in a frame
+static const int64_t CHECK_SLOW_FLUSH = 30000;          // Flush time in microseconds of one and a half frame, every frame drops the next one
+static const int64_t CHECK_LATE_START = 75000;          // Time in microseconds after the first frame at which the second frame starts, the slots at 40 and 60 ms passed before it
+
+static int64_t now = 0;                 // Simulated time, the flushes advance it by exactly their flush time
+static bool has_failed = false;
+
+// Time in microseconds of the simulated clock, the check replaces the clock of the host versions of ESP-IDF so the results are exact
+int64_t esp_timer_get_time(void)
+{
+    return now;
+}
+
+// Reports a failed check of scenario [name] when [is_ok] is false
+static void check(bool is_ok, const char* name, const char* what)
+{
+    if(!is_ok)
+    {
+        printf("  %s: %s\n", name, what);
+        has_failed = true;
+    }
+}
+
+// Runs the loop of the game for the check duration with flushes of [flush_time] microseconds, or of the time [get_flush_time] gives for every frame when it is not NULL
+static void check_run(frame_pacer_t* pacer, int64_t flush_time, int64_t (*get_flush_time)(unsigned int frame))
+{
+    pacer->is_initialized = false;
+    frame_pacer_init(pacer, CHECK_TARGET_FPS);
+    for(int64_t end = now + CHECK_DURATION; now < end; now += CHECK_TICK)
+    {
+        if(!frame_pacer_begin_frame(pacer))
+            continue;
+
+        int64_t time = (get_flush_time != NULL) ? get_flush_time(pacer->presented_frames) : flush_time;
+        now += time;
+        frame_pacer_end_frame(pacer, time);
+    }
+}
+
+// Returns a flush time from 100 to 6400 microseconds that repeats every 64 frames, the ring buffer holds every value once
+static int64_t check_spread_flush_time(unsigned int frame)
+{
+    return (frame % FRAME_PACER_SAMPLE_COUNT + 1) * 100;
+}
+
+// Prints the results of scenario [name]
+static void check_print(frame_pacer_t* pacer, const char* name)
+{
+    printf("%-8s %9u %9u %8.2f %8lld %8lld\n", name, pacer->presented_frames, pacer->dropped_frames, pacer->achieved_fps,
+        (long long)frame_pacer_get_flush_time_percentile(pacer, 50), (long long)frame_pacer_get_flush_time_percentile(pacer, 99));
+}
+
+/*
+    Checks the frame pacer of the game on a simulated clock: flushes that fit in a frame, flushes that take one and a
+    half frame, a spread of flush times for the percentiles and a frame that starts several slots late.
+    Usage: frame_pacer_check
+*/
+int main(int argc, char** argv)
+{
+    frame_pacer_t pacer;
+    printf("%-8s %9s %9s %8s %8s %8s\n", "scenario", "presented", "dropped", "fps", "p50 us", "p99 us");
+
+    // Every frame is presented at the target frame rate
+    check_run(&pacer, CHECK_FAST_FLUSH, NULL);
+    check_print(&pacer, "fast");
+    check(pacer.dropped_frames == 0, "fast", "frames were dropped");
+    check(pacer.presented_frames == CHECK_DURATION / 1000000 * CHECK_TARGET_FPS, "fast", "presented frames differ from the target");
+    check(pacer.achieved_fps > CHECK_TARGET_FPS - 0.5f && pacer.achieved_fps < CHECK_TARGET_FPS + 0.5f, "fast", "achieved frame rate differs from the target");
+    check(frame_pacer_get_flush_time_percentile(&pacer, 50) == CHECK_FAST_FLUSH && frame_pacer_get_flush_time_percentile(&pacer, 99) == CHECK_FAST_FLUSH,
+        "fast", "percentiles differ from the flush time");
+
+    // A flush that runs into the next frame drops it, so every other frame is presented
+    check_run(&pacer, CHECK_SLOW_FLUSH, NULL);
+    check_print(&pacer, "slow");
+    check(pacer.dropped_frames == pacer.presented_frames, "slow", "not one frame dropped per presented frame");
+    check(pacer.achieved_fps > CHECK_TARGET_FPS / 2 - 0.5f && pacer.achieved_fps < CHECK_TARGET_FPS / 2 + 0.5f, "slow", "achieved frame rate is not half the target");
+    check(frame_pacer_get_flush_time_percentile(&pacer, 99) == CHECK_SLOW_FLUSH, "slow", "p99 differs from the flush time");
+
+    // The ring buffer holds the flush times 100 to 6400 once each, nearest rank gives index 32 and 62 of them
+    check_run(&pacer, 0, &check_spread_flush_time);
+    check_print(&pacer, "spread");
+    check(pacer.dropped_frames == 0, "spread", "frames were dropped");
+    check(pacer.presented_frames > FRAME_PACER_SAMPLE_COUNT, "spread", "the ring buffer did not wrap");
+    check(frame_pacer_get_flush_time_percentile(&pacer, 50) == 3300, "spread", "p50 is not 3300 us");
+    check(frame_pacer_get_flush_time_percentile(&pacer, 99) == 6300, "spread", "p99 is not 6300 us");
+    check(frame_pacer_get_flush_time_percentile(&pacer, 0) == 100 && frame_pacer_get_flush_time_percentile(&pacer, 100) == 6400, "spread", "p0 and p100 are not the extremes");
+
+    // A frame that starts more than one slot late drops the slots that passed before it started
+    pacer.is_initialized = false;
+    frame_pacer_init(&pacer, CHECK_TARGET_FPS);
+    int64_t start = now;
+    check(frame_pacer_begin_frame(&pacer), "late", "the first frame was not due");
+    now += CHECK_FAST_FLUSH;
+    frame_pacer_end_frame(&pacer, CHECK_FAST_FLUSH);
+    now = start + CHECK_LATE_START;
+    check(frame_pacer_begin_frame(&pacer), "late", "the late frame was not due");
+    now += CHECK_FAST_FLUSH;
+    frame_pacer_end_frame(&pacer, CHECK_FAST_FLUSH);
+    check_print(&pacer, "late");
+    check(pacer.presented_frames == 2, "late", "not both frames were presented");
+    check(pacer.dropped_frames == 2, "late", "the slots before the late frame were not dropped");
+    check(pacer.next_frame_time == start + 80000, "late", "the next frame is not due in the next slot");
+
+    printf(has_failed ? "FAILED\n" : "OK\n");
+    return has_failed ? 1 : 0;
+}
\ No newline at end of file
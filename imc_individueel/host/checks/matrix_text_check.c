@@ -0,0 +1,91 @@
+/*
+    Author: Kenley Strik
+    Addition: This whole file was written by Kenley Strik
+*/
+
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "i2c_driver.h"
+#include "matrix_array.h"
+#include "matrix_dump.h"
+#include "matrix_text.h"
+#include "ht16k33_model.h"
+
+#define CHECK_PANELS 4                      // Ammount of panels of the matrix array the text is drawn on, next to each other on one bus
+
+static const int CHECK_MARQUEE_STEPS = 48;  // Ammount of steps the marquee is scrolled
+static const int CHECK_MARQUEE_CAPTURE = 6; // Ammount of marquee steps between two captured frames
+
+// Writes the bytes of the dump stream to the dump file
+static bool check_write_dump(void* context, const uint8_t* data, size_t length)
+{
+    return fwrite(data, 1, length, (FILE*)context) == length;
+}
+
+/*
+    Draws strings and scrolls a marquee with the matrix text renderer and records every result in a matrix dump. The
+    Makefile turns the dump into ASCII art with matrix_dump and compares it with the golden frames in golden/
+    Usage: matrix_text_check <dump file>
+*/
+int main(int argc, char** argv)
+{
+    if(argc < 2)
+    {
+        fprintf(stderr, "Usage: %s <dump file>\n", argv[0]);
+        return 2;
+    }
+    FILE* stream = fopen(argv[1], "wb");
+    if(stream == NULL)
+    {
+        fprintf(stderr, "%s: cannot create\n", argv[1]);
+        return 2;
+    }
+
+    static ht16k33_model_t models[CHECK_PANELS];
+    matrix_array_display_address_t addresses[CHECK_PANELS];
+    for(int i = 0; i < CHECK_PANELS; i++)
+    {
+        addresses[i] = (matrix_array_display_address_t){ I2C_NUM_0, (uint8_t)(0x70 + i) };
+        ht16k33_model_init(&models[i], addresses[i].i2c_address);
+        ht16k33_model_attach(&models[i], I2C_NUM_0);
+    }
+    i2c_driver_init(I2C_NUM_0, I2C_MODE_MASTER, 23, 22, GPIO_PULLUP_ENABLE, GPIO_PULLUP_ENABLE, 400000);
+    matrix_array_t* array = (matrix_array_t*)malloc(sizeof(matrix_array_t));
+    array->is_initialized = false;
+    matrix_array_init(&array, HORIZONTAL);
+    matrix_array_add_matrix_displays(&array, addresses, CHECK_PANELS);
+
+    matrix_dump_t dump;
+    if(!matrix_dump_init(&dump, &array, &check_write_dump, stream))
+        return 1;
+
+    // Strings in both fonts, the last one is cut off on both sides of the matrix array
+    matrix_text_draw_string(&array, &matrix_font_5x7, 1, 0, "Hi 42");
+    matrix_dump_capture(&dump, &array);
+    matrix_array_clear(&array);
+    matrix_text_draw_string(&array, &matrix_font_3x5, 0, 1, "12:34");
+    matrix_text_draw_string(&array, &matrix_font_3x5, 21, 1, "ok");
+    matrix_dump_capture(&dump, &array);
+    matrix_array_clear(&array);
+    matrix_text_draw_string(&array, &matrix_font_5x7, -7, 1, "WIDE TEXT");
+    matrix_dump_capture(&dump, &array);
+
+    // The marquee enters on the right edge and moves one column to the left per step
+    matrix_array_clear(&array);
+    matrix_text_marquee_t marquee = { .is_initialized = false };
+    matrix_text_marquee_init(&marquee, &matrix_font_5x7, "FLAPPY", 0);
+    for(int i = 1; i <= CHECK_MARQUEE_STEPS; i++)
+    {
+        matrix_text_marquee_step(&marquee, &array);
+        if(i % CHECK_MARQUEE_CAPTURE == 0)
+            matrix_dump_capture(&dump, &array);
+    }
+
+    matrix_dump_deinit(&dump);
+    fclose(stream);
+    matrix_array_deinit(&array);
+    free(array);
+    i2c_driver_deinit(I2C_NUM_0);
+    return 0;
+}
\ No newline at end of file
@@ -0,0 +1,141 @@
+/*
+    Author: Kenley Strik
+    Addition: This whole file was written by Kenley Strik
+*/
+
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "esp_timer.h"
+#include "fixed_step.h"
+#include "flappy_policy.h"
+
+static const unsigned int CHECK_TUNING_RATE = 100;      // Step rate the rules of the game are tuned for, like FLAPPY_BIRD_TUNING_RATE
+static const unsigned int CHECK_STEP_RATE = 200;        // Step rate the game is compared at, a multiple of the tuning rate
+static const unsigned long CHECK_TUNING_STEPS = 6000;   // Ammount of steps at the tuning rate the games are compared for, a minute of play
+static const fixed_t CHECK_TOLERANCE = FIXED_POINT_ONE / 8;     // Largest difference in fixed-point pixels allowed between the two games
+static const unsigned int CHECK_SEED = 5;
+
+static int64_t now = 0;                 // Simulated time for the fixed step accumulator
+static bool has_failed = false;
+
+// Time in microseconds of the simulated clock, the check replaces the clock of the host versions of ESP-IDF so the results are exact
+int64_t esp_timer_get_time(void)
+{
+    return now;
+}
+
+// Reports a failed check of scenario [name] when [is_ok] is false
+static void check(bool is_ok, const char* name, const char* what)
+{
+    if(!is_ok)
+    {
+        printf("  %s: %s\n", name, what);
+        has_failed = true;
+    }
+}
+
+/*
+    Plays the game at the tuning rate with the autopilot and plays the same flaps at the check step rate with the
+    deltatime scaled like the game task scales it, the bird and the pipelanes have to be in the same place after
+    every step at the tuning rate. The scaled game also tests the collisions between those steps, so it ends every
+    round the tuned game ends and some rounds in which the tuned game skipped past the corner of a pipe, the tuned game
+    starts a new round as well then
+*/
+static void check_step_rate(void)
+{
+    flappy_bird_sim_config_t config;
+    flappy_bird_sim_default_config(&config);
+    flappy_bird_sim_t tuned, scaled;
+    if(!flappy_bird_sim_init(&tuned, &config, CHECK_SEED))
+        exit(1);
+    config.deltatime = FIXED_FROM_INT(CHECK_TUNING_RATE) / CHECK_STEP_RATE;
+    if(!flappy_bird_sim_init(&scaled, &config, CHECK_SEED))
+        exit(1);
+    flappy_policy_t policy;
+    flappy_policy_init(&policy, FLAPPY_POLICY_AUTOPILOT, CHECK_SEED);
+
+    fixed_t bird_difference = 0, pipelane_difference = 0;
+    unsigned long missed_crashes = 0, extra_crashes = 0;
+    for(unsigned long i = 0; i < CHECK_TUNING_STEPS; i++)
+    {
+        // The flap is done by the first of the steps the scaled game takes for one step of the tuned game
+        bool flap = flappy_policy_decide(&policy, &tuned);
+        unsigned int events = flappy_bird_sim_step(&tuned, flap);
+        unsigned int scaled_events = 0;
+        for(unsigned int step = 0; step < CHECK_STEP_RATE / CHECK_TUNING_RATE; step++)
+            scaled_events |= flappy_bird_sim_step(&scaled, flap && step == 0);
+
+        bool has_crashed = (events & FLAPPY_BIRD_SIM_EVENT_CRASH) != 0;
+        bool has_scaled_crashed = (scaled_events & FLAPPY_BIRD_SIM_EVENT_CRASH) != 0;
+        if(has_crashed && !has_scaled_crashed)
+        {
+            missed_crashes++;
+            flappy_bird_sim_reset(&scaled);
+        }
+        else if(!has_crashed && has_scaled_crashed)
+        {
+            extra_crashes++;
+            flappy_bird_sim_reset(&tuned);
+        }
+        fixed_t difference = abs(tuned.bird.yPosition - scaled.bird.yPosition);
+        if(difference > bird_difference)
+            bird_difference = difference;
+        for(unsigned int p = 0; p < tuned.pipelanes.count; p++)
+        {
+            difference = abs(tuned.pipelanes.xPositions[p] - scaled.pipelanes.xPositions[p]);
+            if(difference > pipelane_difference)
+                pipelane_difference = difference;
+        }
+    }
+
+    printf("%u vs %u steps per second: %lu rounds, largest difference bird %.3f, pipelanes %.3f pixels, %lu crashes between steps\n", CHECK_TUNING_RATE, CHECK_STEP_RATE,
+        scaled.crash_count, bird_difference / (float)FIXED_POINT_ONE, pipelane_difference / (float)FIXED_POINT_ONE, extra_crashes);
+    check(bird_difference <= CHECK_TOLERANCE, "step rate", "the path of the bird depends on the step rate");
+    check(pipelane_difference <= CHECK_TOLERANCE, "step rate", "the pipelanes move at another speed");
+    check(missed_crashes == 0, "step rate", "the scaled game missed crashes of the tuned game");
+    check(extra_crashes * 4 < scaled.crash_count, "step rate", "more than a quarter of the rounds end between steps");
+    flappy_bird_sim_deinit(&tuned);
+    flappy_bird_sim_deinit(&scaled);
+}
+
+// Checks that the accumulator hands out the steps that are due, keeps the remainder and drops what is beyond the maximum after a stall
+static void check_fixed_step(void)
+{
+    fixed_step_t fixed_step = { .is_initialized = false };
+    fixed_step_init(&fixed_step, 100, 5);      // 10 ms steps, at most 5 at once
+
+    check(fixed_step_advance(&fixed_step) == 0, "fixed step", "steps without time passing");
+    now += 25000;
+    check(fixed_step_advance(&fixed_step) == 2, "fixed step", "not 2 steps after 25 ms");
+    check(fixed_step_get_alpha(&fixed_step) == 0.5f, "fixed step", "the 5 ms left are not half a step");
+
+    // A stall of 200 ms makes 20 steps due, 5 are handed out and 15 dropped, the remainder is kept
+    now += 200000;
+    check(fixed_step_advance(&fixed_step) == 5, "fixed step", "not clamped to 5 steps after a stall");
+    check(fixed_step.dropped_steps == 15, "fixed step", "not 15 steps dropped after a stall");
+    now += 5000;
+    check(fixed_step_advance(&fixed_step) == 1, "fixed step", "the remainder was not kept after a stall");
+    check(fixed_step.step_count == 8, "fixed step", "not 8 steps handed out");
+
+    // A reset forgets the time that passed while the simulation was paused
+    now += 1000000;
+    fixed_step_reset(&fixed_step);
+    now += 10000;
+    check(fixed_step_advance(&fixed_step) == 1 && fixed_step.dropped_steps == 0, "fixed step", "time before the reset was handed out");
+    printf("fixed step: %lu steps, %lu dropped\n", fixed_step.step_count, fixed_step.dropped_steps);
+}
+
+/*
+    Checks that the game plays the same at another step rate with the deltatime scaled, and that the fixed step
+    accumulator of the game task clamps the steps after a stall.
+    Usage: step_rate_check
+*/
+int main(int argc, char** argv)
+{
+    check_step_rate();
+    check_fixed_step();
+
+    printf(has_failed ? "FAILED\n" : "OK\n");
+    return has_failed ? 1 : 0;
+}
\ No newline at end of file
@@ -0,0 +1,159 @@
+/*
+    Author: Kenley Strik
+    Addition: This whole file was written by Kenley Strik
+*/
+
+#define _GNU_SOURCE
+
+#include <pthread.h>
+#include <time.h>
+#include <errno.h>
+#include <stdlib.h>
+#include <stdbool.h>
+
+#include "esp_timer.h"
+
+// Type for representing a high resolution timer of esp_timer
+struct esp_timer
+{
+    struct esp_timer* next;                 // Next timer in the list of the timer thread
+    esp_timer_cb_t callback;                // Function called when the timer expires
+    void* arg;                              // Argument passed to the callback
+    int64_t expiry_time;                    // Time in microseconds at which the timer expires
+    int64_t period;                         // Period in microseconds of a periodic timer, 0 for a one-shot timer
+    bool is_active;                         // Boolean value for indicating if the timer is running
+};
+
+static struct esp_timer* timers = NULL;
+static pthread_mutex_t timer_mutex = PTHREAD_MUTEX_INITIALIZER;
+static pthread_cond_t timer_condition = PTHREAD_COND_INITIALIZER;
+static bool is_timer_thread_started = false;
+
+// Function for the thread that calls the callbacks of the timers when they expire, one at a time like the esp_timer task
+static void* esp_timer_thread(void* arg)
+{
+    pthread_mutex_lock(&timer_mutex);
+    while(true)
+    {
+        // Find the timer that expires first
+        struct esp_timer* first_timer = NULL;
+        for(struct esp_timer* timer = timers; timer != NULL; timer = timer->next)
+        {
+            if(timer->is_active && (first_timer == NULL || timer->expiry_time < first_timer->expiry_time))
+                first_timer = timer;
+        }
+
+        if(first_timer == NULL)
+        {
+            pthread_cond_wait(&timer_condition, &timer_mutex);
+            continue;
+        }
+
+        int64_t now = esp_timer_get_time();
+        if(first_timer->expiry_time > now)
+        {
+            // Wait until the timer expires or the timers change
+            struct timespec deadline;
+            clock_gettime(CLOCK_REALTIME, &deadline);
+            int64_t nanoseconds = deadline.tv_nsec + (first_timer->expiry_time - now) * 1000;
+            deadline.tv_sec += nanoseconds / 1000000000;
+            deadline.tv_nsec = nanoseconds % 1000000000;
+            pthread_cond_timedwait(&timer_condition, &timer_mutex, &deadline);
+            continue;
+        }
+
+        if(first_timer->period > 0)
+            first_timer->expiry_time += first_timer->period;
+        else
+            first_timer->is_active = false;
+
+        // The callback may start or stop timers itself
+        esp_timer_cb_t callback = first_timer->callback;
+        void* callback_arg = first_timer->arg;
+        pthread_mutex_unlock(&timer_mutex);
+        callback(callback_arg);
+        pthread_mutex_lock(&timer_mutex);
+    }
+    return NULL;
+}
+
+esp_err_t esp_timer_create(const esp_timer_create_args_t* create_args, esp_timer_handle_t* out_handle)
+{
+    struct esp_timer* timer = (struct esp_timer*)calloc(1, sizeof(struct esp_timer));
+    if(timer == NULL)
+        return ESP_ERR_NO_MEM;
+    timer->callback = create_args->callback;
+    timer->arg = create_args->arg;
+
+    pthread_mutex_lock(&timer_mutex);
+    timer->next = timers;
+    timers = timer;
+    if(!is_timer_thread_started)
+    {
+        pthread_t thread;
+        pthread_create(&thread, NULL, &esp_timer_thread, NULL);
+        pthread_detach(thread);
+        is_timer_thread_started = true;
+    }
+    pthread_mutex_unlock(&timer_mutex);
+
+    *out_handle = timer;
+    return ESP_OK;
+}
+
+// Starts [timer] to expire in [timeout] microseconds and every [period] microseconds after that if [period] is not 0
+static esp_err_t esp_timer_start(esp_timer_handle_t timer, uint64_t timeout, uint64_t period)
+{
+    pthread_mutex_lock(&timer_mutex);
+    if(timer->is_active)
+    {
+        pthread_mutex_unlock(&timer_mutex);
+        return ESP_ERR_INVALID_STATE;
+    }
+    timer->expiry_time = esp_timer_get_time() + (int64_t)timeout;
+    timer->period = (int64_t)period;
+    timer->is_active = true;
+    pthread_cond_broadcast(&timer_condition);
+    pthread_mutex_unlock(&timer_mutex);
+    return ESP_OK;
+}
+
+esp_err_t esp_timer_start_once(esp_timer_handle_t timer, uint64_t timeout_us)
+{
+    return esp_timer_start(timer, timeout_us, 0);
+}
+
+esp_err_t esp_timer_start_periodic(esp_timer_handle_t timer, uint64_t period)
+{
+    return esp_timer_start(timer, period, period);
+}
+
+esp_err_t esp_timer_stop(esp_timer_handle_t timer)
+{
+    pthread_mutex_lock(&timer_mutex);
+    bool was_active = timer->is_active;
+    timer->is_active = false;
+    pthread_mutex_unlock(&timer_mutex);
+    return was_active ? ESP_OK : ESP_ERR_INVALID_STATE;
+}
+
+esp_err_t esp_timer_delete(esp_timer_handle_t timer)
+{
+    pthread_mutex_lock(&timer_mutex);
+    if(timer->is_active)
+    {
+        pthread_mutex_unlock(&timer_mutex);
+        return ESP_ERR_INVALID_STATE;
+    }
+    for(struct esp_timer** entry = &timers; *entry != NULL; entry = &(*entry)->next)
+    {
+        if(*entry == timer)
+        {
+            *entry = timer->next;
+            break;
+        }
+    }
+    pthread_mutex_unlock(&timer_mutex);
+    free(timer);
+    return ESP_OK;
+}
\ No newline at end of file
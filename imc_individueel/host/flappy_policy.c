@@ -0,0 +1,74 @@
+/*
+    Author: Kenley Strik
+    Addition: This whole file was written by Kenley Strik
+*/
+
+#include <string.h>
+
+#include "flappy_policy.h"
+
+static const char* FLAPPY_POLICY_NAMES[FLAPPY_POLICY_COUNT] = { "autopilot", "noisy", "random" };
+static const uint32_t FLAPPY_POLICY_NOISY_MISS = 8;      // The noisy policy misses one in this ammount of flaps
+static const uint32_t FLAPPY_POLICY_NOISY_EXTRA = 64;    // The noisy policy flaps when it should not once in this ammount of steps
+static const uint32_t FLAPPY_POLICY_RANDOM_FLAP = 8;     // The random policy flaps once in this ammount of steps
+
+// Returns true if the autopilot flaps during the next step, it flaps when the bird falls below the middle of the next opening
+static bool flappy_policy_autopilot(const flappy_bird_sim_t* sim)
+{
+    // The pipelanes are kept from left to right, the first one that is not behind the bird is the next one
+    const pipelane_pool_t* pipelanes = &sim->pipelanes;
+    fixed_t target = FIXED_FROM_INT(8);
+    for(unsigned int order = 0; order < pipelanes->count; order++)
+    {
+        unsigned int index = pipelane_pool_get_index(pipelanes, order);
+        if(pipelanes->xPositions[index] >= sim->bird.xPosition)
+        {
+            target = pipelanes->openingYPositions[index];
+            break;
+        }
+    }
+
+    return !sim->is_started || (sim->bird.yVelocity >= 0 && sim->bird.yPosition > target);
+}
+
+// Initializes the policy given to the function to play with [type] and its random generator at [seed]
+void flappy_policy_init(flappy_policy_t* policy, flappy_policy_type_t type, unsigned int seed)
+{
+    policy->type = type;
+    pcg_random_seed(&policy->random, seed, FLAPPY_POLICY_RANDOM_STREAM);
+}
+
+// Returns true if the policy flaps during the next step of [sim]
+bool flappy_policy_decide(flappy_policy_t* policy, const flappy_bird_sim_t* sim)
+{
+    switch(policy->type)
+    {
+        case FLAPPY_POLICY_AUTOPILOT:
+            return flappy_policy_autopilot(sim);
+        case FLAPPY_POLICY_NOISY:
+            if(flappy_policy_autopilot(sim))
+                return pcg_random_below(&policy->random, FLAPPY_POLICY_NOISY_MISS) != 0;
+            return pcg_random_below(&policy->random, FLAPPY_POLICY_NOISY_EXTRA) == 0;
+        case FLAPPY_POLICY_RANDOM:
+            return pcg_random_below(&policy->random, FLAPPY_POLICY_RANDOM_FLAP) == 0;
+        default:
+            return false;
+    }
+}
+
+// Returns the name of [type], or NULL if there is no such policy
+const char* flappy_policy_get_name(flappy_policy_type_t type)
+{
+    return (type >= 0 && type < FLAPPY_POLICY_COUNT) ? FLAPPY_POLICY_NAMES[type] : NULL;
+}
+
+// Returns the policy called [name], or FLAPPY_POLICY_COUNT if there is no such policy
+flappy_policy_type_t flappy_policy_from_name(const char* name)
+{
+    for(int i = 0; i < FLAPPY_POLICY_COUNT; i++)
+    {
+        if(strcmp(name, FLAPPY_POLICY_NAMES[i]) == 0)
+            return (flappy_policy_type_t)i;
+    }
+    return FLAPPY_POLICY_COUNT;
+}
\ No newline at end of file
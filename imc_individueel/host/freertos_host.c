@@ -0,0 +1,515 @@
+/*
+    Author: Kenley Strik
+    Addition: This whole file was written by Kenley Strik
+*/
+
+#define _GNU_SOURCE
+
+#include <pthread.h>
+#include <sched.h>
+#include <time.h>
+#include <errno.h>
+#include <stdlib.h>
+
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+#include "freertos/semphr.h"
+#include "freertos/event_groups.h"
+#include "freertos/timers.h"
+#include "esp_timer.h"
+#include "esp_system.h"
+
+#define HOST_MAX_TASKS 64                   // Maximum ammount of tasks that can use task notifications at the same time
+
+static const int64_t HOST_TICK_PERIOD = 1000000 / configTICK_RATE_HZ;     // Time in microseconds of one tick
+
+// Type for representing a task that is started on a thread
+typedef struct
+{
+    TaskFunction_t function;                // Function of the task
+    void* parameter;                        // Parameter passed to the function of the task
+} host_task_start_t;
+
+// Type for representing the notification value of a task
+typedef struct
+{
+    pthread_t thread;                       // Thread of the task
+    uint32_t value;                         // Notification value of the task
+    bool is_used;                           // Boolean value for indicating if the entry belongs to a task
+} host_notification_t;
+
+// Type for representing a mutex or binary semaphore
+typedef struct
+{
+    pthread_mutex_t mutex;                  // Mutex guarding the count
+    pthread_cond_t condition;               // Condition signalled when the count is raised
+    int count;                              // Ammount of times the semaphore can be taken
+    int max_count;                          // Maximum count of the semaphore
+} host_semaphore_t;
+
+// Type for representing an event group
+typedef struct
+{
+    pthread_mutex_t mutex;                  // Mutex guarding the bits
+    pthread_cond_t condition;               // Condition signalled when bits are set
+    EventBits_t bits;                       // Bits of the event group
+} host_event_group_t;
+
+// Type for representing a software timer
+typedef struct host_timer
+{
+    struct host_timer* next;                // Next timer in the list of the timer thread
+    TickType_t period;                      // Period of the timer in ticks
+    bool is_auto_reload;                    // Boolean value for indicating if the timer restarts after it expired
+    bool is_active;                         // Boolean value for indicating if the timer is running
+    int64_t expiry_time;                    // Time in microseconds at which the timer expires
+    void* timer_id;                         // Identifier of the timer
+    TimerCallbackFunction_t callback;       // Function called when the timer expires
+} host_timer_t;
+
+static host_notification_t notifications[HOST_MAX_TASKS];
+static pthread_mutex_t notification_mutex = PTHREAD_MUTEX_INITIALIZER;
+static pthread_cond_t notification_condition = PTHREAD_COND_INITIALIZER;
+
+static host_timer_t* timers = NULL;
+static pthread_mutex_t timer_mutex = PTHREAD_MUTEX_INITIALIZER;
+static pthread_cond_t timer_condition = PTHREAD_COND_INITIALIZER;
+static bool is_timer_thread_started = false;
+
+static int64_t boot_time = 0;
+
+// Returns the time of the monotonic clock in microseconds
+static int64_t host_get_monotonic_time(void)
+{
+    struct timespec time;
+    clock_gettime(CLOCK_MONOTONIC, &time);
+    return (int64_t)time.tv_sec * 1000000 + time.tv_nsec / 1000;
+}
+
+// Remembers the time the program started, esp_timer_get_time counts from there like the time since boot on the target
+__attribute__((constructor)) static void host_boot(void)
+{
+    boot_time = host_get_monotonic_time();
+}
+
+// Fills [deadline] with the time of the realtime clock [timeout] microseconds from now, for the timed waits of POSIX threads
+static void host_get_deadline(struct timespec* deadline, int64_t timeout)
+{
+    clock_gettime(CLOCK_REALTIME, deadline);
+    int64_t nanoseconds = deadline->tv_nsec + timeout * 1000;
+    deadline->tv_sec += nanoseconds / 1000000000;
+    deadline->tv_nsec = nanoseconds % 1000000000;
+}
+
+// Sleeps for [duration] microseconds
+static void host_sleep(int64_t duration)
+{
+    if(duration <= 0)
+        return;
+
+    struct timespec time = { duration / 1000000, (duration % 1000000) * 1000 };
+    while(nanosleep(&time, &time) == -1 && errno == EINTR);
+}
+
+int64_t esp_timer_get_time(void)
+{
+    return host_get_monotonic_time() - boot_time;
+}
+
+uint32_t esp_random(void)
+{
+    return (uint32_t)random() ^ ((uint32_t)random() << 16);
+}
+
+// Function for the thread of a task
+static void* host_task_thread(void* arg)
+{
+    host_task_start_t start = *(host_task_start_t*)arg;
+    free(arg);
+    start.function(start.parameter);
+    return NULL;
+}
+
+BaseType_t xTaskCreatePinnedToCore(TaskFunction_t function, const char* name, uint32_t stack_size, void* parameter, UBaseType_t priority, TaskHandle_t* handle, BaseType_t core_id)
+{
+    host_task_start_t* start = (host_task_start_t*)malloc(sizeof(host_task_start_t));
+    if(start == NULL)
+        return pdFAIL;
+    start->function = function;
+    start->parameter = parameter;
+
+    pthread_t thread;
+    if(pthread_create(&thread, NULL, &host_task_thread, start) != 0)
+    {
+        free(start);
+        return pdFAIL;
+    }
+    pthread_detach(thread);
+
+    if(handle != NULL)
+        *handle = (TaskHandle_t)thread;
+    return pdPASS;
+}
+
+BaseType_t xTaskCreate(TaskFunction_t function, const char* name, uint32_t stack_size, void* parameter, UBaseType_t priority, TaskHandle_t* handle)
+{
+    return xTaskCreatePinnedToCore(function, name, stack_size, parameter, priority, handle, tskNO_AFFINITY);
+}
+
+void vTaskDelete(TaskHandle_t handle)
+{
+    // Forget the notification value of the task, its thread can be reused by a new task
+    pthread_t thread = (handle == NULL) ? pthread_self() : (pthread_t)handle;
+    pthread_mutex_lock(&notification_mutex);
+    for(int i = 0; i < HOST_MAX_TASKS; i++)
+    {
+        if(notifications[i].is_used && pthread_equal(notifications[i].thread, thread))
+            notifications[i].is_used = false;
+    }
+    pthread_mutex_unlock(&notification_mutex);
+
+    if(pthread_equal(thread, pthread_self()))
+        pthread_exit(NULL);
+    pthread_cancel(thread);
+}
+
+TaskHandle_t xTaskGetCurrentTaskHandle(void)
+{
+    return (TaskHandle_t)pthread_self();
+}
+
+void vTaskDelay(TickType_t ticks)
+{
+    if(ticks == 0)
+        sched_yield();
+    host_sleep((int64_t)ticks * HOST_TICK_PERIOD);
+}
+
+void vTaskDelayUntil(TickType_t* previous_wake_time, TickType_t increment)
+{
+    *previous_wake_time += increment;
+    host_sleep((int64_t)*previous_wake_time * HOST_TICK_PERIOD - esp_timer_get_time());
+}
+
+TickType_t xTaskGetTickCount(void)
+{
+    return (TickType_t)(esp_timer_get_time() / HOST_TICK_PERIOD);
+}
+
+// Returns the notification value of the task on [thread], the notification mutex has to be taken
+static host_notification_t* host_get_notification(pthread_t thread)
+{
+    host_notification_t* unused = NULL;
+    for(int i = 0; i < HOST_MAX_TASKS; i++)
+    {
+        if(notifications[i].is_used && pthread_equal(notifications[i].thread, thread))
+            return &notifications[i];
+        if(!notifications[i].is_used && unused == NULL)
+            unused = &notifications[i];
+    }
+
+    if(unused != NULL)
+    {
+        unused->thread = thread;
+        unused->value = 0;
+        unused->is_used = true;
+    }
+    return unused;
+}
+
+BaseType_t xTaskNotifyGive(TaskHandle_t handle)
+{
+    pthread_mutex_lock(&notification_mutex);
+    host_notification_t* notification = host_get_notification((pthread_t)handle);
+    if(notification != NULL)
+        notification->value++;
+    pthread_cond_broadcast(&notification_condition);
+    pthread_mutex_unlock(&notification_mutex);
+    return pdPASS;
+}
+
+uint32_t ulTaskNotifyTake(BaseType_t clear_on_exit, TickType_t ticks_to_wait)
+{
+    struct timespec deadline;
+    host_get_deadline(&deadline, (int64_t)ticks_to_wait * HOST_TICK_PERIOD);
+
+    pthread_mutex_lock(&notification_mutex);
+    host_notification_t* notification = host_get_notification(pthread_self());
+    while(notification->value == 0)
+    {
+        if(ticks_to_wait == portMAX_DELAY)
+            pthread_cond_wait(&notification_condition, &notification_mutex);
+        else if(pthread_cond_timedwait(&notification_condition, &notification_mutex, &deadline) == ETIMEDOUT)
+            break;
+    }
+
+    uint32_t value = notification->value;
+    if(value > 0)
+        notification->value = clear_on_exit ? 0 : value - 1;
+    pthread_mutex_unlock(&notification_mutex);
+    return value;
+}
+
+// Creates a semaphore that can be taken [count] times and given back up to [max_count] times
+static host_semaphore_t* host_create_semaphore(int count, int max_count)
+{
+    host_semaphore_t* semaphore = (host_semaphore_t*)calloc(1, sizeof(host_semaphore_t));
+    if(semaphore == NULL)
+        return NULL;
+
+    pthread_mutex_init(&semaphore->mutex, NULL);
+    pthread_cond_init(&semaphore->condition, NULL);
+    semaphore->count = count;
+    semaphore->max_count = max_count;
+    return semaphore;
+}
+
+SemaphoreHandle_t xSemaphoreCreateMutex(void)
+{
+    return host_create_semaphore(1, 1);
+}
+
+SemaphoreHandle_t xSemaphoreCreateBinary(void)
+{
+    return host_create_semaphore(0, 1);
+}
+
+BaseType_t xSemaphoreTake(SemaphoreHandle_t handle, TickType_t ticks_to_wait)
+{
+    host_semaphore_t* semaphore = (host_semaphore_t*)handle;
+    struct timespec deadline;
+    host_get_deadline(&deadline, (int64_t)ticks_to_wait * HOST_TICK_PERIOD);
+
+    pthread_mutex_lock(&semaphore->mutex);
+    while(semaphore->count == 0)
+    {
+        if(ticks_to_wait == portMAX_DELAY)
+            pthread_cond_wait(&semaphore->condition, &semaphore->mutex);
+        else if(pthread_cond_timedwait(&semaphore->condition, &semaphore->mutex, &deadline) == ETIMEDOUT)
+        {
+            pthread_mutex_unlock(&semaphore->mutex);
+            return pdFALSE;
+        }
+    }
+    semaphore->count--;
+    pthread_mutex_unlock(&semaphore->mutex);
+    return pdTRUE;
+}
+
+BaseType_t xSemaphoreGive(SemaphoreHandle_t handle)
+{
+    host_semaphore_t* semaphore = (host_semaphore_t*)handle;
+    BaseType_t result = pdFALSE;
+
+    pthread_mutex_lock(&semaphore->mutex);
+    if(semaphore->count < semaphore->max_count)
+    {
+        semaphore->count++;
+        pthread_cond_broadcast(&semaphore->condition);
+        result = pdTRUE;
+    }
+    pthread_mutex_unlock(&semaphore->mutex);
+    return result;
+}
+
+void vSemaphoreDelete(SemaphoreHandle_t handle)
+{
+    host_semaphore_t* semaphore = (host_semaphore_t*)handle;
+    if(semaphore == NULL)
+        return;
+
+    pthread_mutex_destroy(&semaphore->mutex);
+    pthread_cond_destroy(&semaphore->condition);
+    free(semaphore);
+}
+
+EventGroupHandle_t xEventGroupCreate(void)
+{
+    host_event_group_t* event_group = (host_event_group_t*)calloc(1, sizeof(host_event_group_t));
+    if(event_group == NULL)
+        return NULL;
+
+    pthread_mutex_init(&event_group->mutex, NULL);
+    pthread_cond_init(&event_group->condition, NULL);
+    return event_group;
+}
+
+void vEventGroupDelete(EventGroupHandle_t handle)
+{
+    host_event_group_t* event_group = (host_event_group_t*)handle;
+    pthread_mutex_destroy(&event_group->mutex);
+    pthread_cond_destroy(&event_group->condition);
+    free(event_group);
+}
+
+EventBits_t xEventGroupSetBits(EventGroupHandle_t handle, EventBits_t bits)
+{
+    host_event_group_t* event_group = (host_event_group_t*)handle;
+    pthread_mutex_lock(&event_group->mutex);
+    event_group->bits |= bits;
+    EventBits_t result = event_group->bits;
+    pthread_cond_broadcast(&event_group->condition);
+    pthread_mutex_unlock(&event_group->mutex);
+    return result;
+}
+
+EventBits_t xEventGroupClearBits(EventGroupHandle_t handle, EventBits_t bits)
+{
+    host_event_group_t* event_group = (host_event_group_t*)handle;
+    pthread_mutex_lock(&event_group->mutex);
+    EventBits_t result = event_group->bits;     // The bits before they were cleared, like FreeRTOS returns them
+    event_group->bits &= ~bits;
+    pthread_mutex_unlock(&event_group->mutex);
+    return result;
+}
+
+EventBits_t xEventGroupGetBits(EventGroupHandle_t handle)
+{
+    host_event_group_t* event_group = (host_event_group_t*)handle;
+    pthread_mutex_lock(&event_group->mutex);
+    EventBits_t result = event_group->bits;
+    pthread_mutex_unlock(&event_group->mutex);
+    return result;
+}
+
+EventBits_t xEventGroupWaitBits(EventGroupHandle_t handle, EventBits_t bits, BaseType_t clear_on_exit, BaseType_t wait_for_all, TickType_t ticks_to_wait)
+{
+    host_event_group_t* event_group = (host_event_group_t*)handle;
+    struct timespec deadline;
+    host_get_deadline(&deadline, (int64_t)ticks_to_wait * HOST_TICK_PERIOD);
+
+    pthread_mutex_lock(&event_group->mutex);
+    bool is_met = false;
+    while(!(is_met = wait_for_all ? (event_group->bits & bits) == bits : (event_group->bits & bits) != 0))
+    {
+        if(ticks_to_wait == portMAX_DELAY)
+            pthread_cond_wait(&event_group->condition, &event_group->mutex);
+        else if(pthread_cond_timedwait(&event_group->condition, &event_group->mutex, &deadline) == ETIMEDOUT)
+            break;
+    }
+
+    EventBits_t result = event_group->bits;
+    if(is_met && clear_on_exit)
+        event_group->bits &= ~bits;
+    pthread_mutex_unlock(&event_group->mutex);
+    return result;
+}
+
+// Function for the thread that calls the callbacks of the software timers when they expire, one at a time like the timer service task
+static void* host_timer_thread(void* arg)
+{
+    pthread_mutex_lock(&timer_mutex);
+    while(true)
+    {
+        // Find a timer that expired and the time the first running timer expires
+        int64_t now = esp_timer_get_time();
+        int64_t next_expiry_time = INT64_MAX;
+        host_timer_t* expired_timer = NULL;
+        for(host_timer_t* timer = timers; timer != NULL && expired_timer == NULL; timer = timer->next)
+        {
+            if(!timer->is_active)
+                continue;
+            if(timer->expiry_time <= now)
+                expired_timer = timer;
+            else if(timer->expiry_time < next_expiry_time)
+                next_expiry_time = timer->expiry_time;
+        }
+
+        if(expired_timer != NULL)
+        {
+            if(expired_timer->is_auto_reload)
+                expired_timer->expiry_time += (int64_t)expired_timer->period * HOST_TICK_PERIOD;
+            else
+                expired_timer->is_active = false;
+
+            // The callback may start or stop timers itself
+            TimerCallbackFunction_t callback = expired_timer->callback;
+            pthread_mutex_unlock(&timer_mutex);
+            callback(expired_timer);
+            pthread_mutex_lock(&timer_mutex);
+        }
+        else if(next_expiry_time == INT64_MAX)
+            pthread_cond_wait(&timer_condition, &timer_mutex);
+        else
+        {
+            struct timespec deadline;
+            host_get_deadline(&deadline, next_expiry_time - now);
+            pthread_cond_timedwait(&timer_condition, &timer_mutex, &deadline);
+        }
+    }
+    return NULL;
+}
+
+TimerHandle_t xTimerCreate(const char* name, TickType_t period, UBaseType_t auto_reload, void* timer_id, TimerCallbackFunction_t callback)
+{
+    host_timer_t* timer = (host_timer_t*)calloc(1, sizeof(host_timer_t));
+    if(timer == NULL)
+        return NULL;
+    timer->period = period;
+    timer->is_auto_reload = auto_reload;
+    timer->timer_id = timer_id;
+    timer->callback = callback;
+
+    pthread_mutex_lock(&timer_mutex);
+    timer->next = timers;
+    timers = timer;
+    if(!is_timer_thread_started)
+    {
+        pthread_t thread;
+        pthread_create(&thread, NULL, &host_timer_thread, NULL);
+        pthread_detach(thread);
+        is_timer_thread_started = true;
+    }
+    pthread_mutex_unlock(&timer_mutex);
+    return timer;
+}
+
+BaseType_t xTimerStart(TimerHandle_t handle, TickType_t ticks_to_wait)
+{
+    host_timer_t* timer = (host_timer_t*)handle;
+    pthread_mutex_lock(&timer_mutex);
+    timer->is_active = true;
+    timer->expiry_time = esp_timer_get_time() + (int64_t)timer->period * HOST_TICK_PERIOD;
+    pthread_cond_broadcast(&timer_condition);
+    pthread_mutex_unlock(&timer_mutex);
+    return pdPASS;
+}
+
+BaseType_t xTimerStop(TimerHandle_t handle, TickType_t ticks_to_wait)
+{
+    host_timer_t* timer = (host_timer_t*)handle;
+    pthread_mutex_lock(&timer_mutex);
+    timer->is_active = false;
+    pthread_mutex_unlock(&timer_mutex);
+    return pdPASS;
+}
+
+BaseType_t xTimerChangePeriod(TimerHandle_t handle, TickType_t period, TickType_t ticks_to_wait)
+{
+    host_timer_t* timer = (host_timer_t*)handle;
+    pthread_mutex_lock(&timer_mutex);
+    timer->period = period;
+    pthread_mutex_unlock(&timer_mutex);
+    return xTimerStart(handle, ticks_to_wait);     // Changing the period starts the timer, like it does in FreeRTOS
+}
+
+BaseType_t xTimerDelete(TimerHandle_t handle, TickType_t ticks_to_wait)
+{
+    pthread_mutex_lock(&timer_mutex);
+    for(host_timer_t** timer = &timers; *timer != NULL; timer = &(*timer)->next)
+    {
+        if(*timer == (host_timer_t*)handle)
+        {
+            *timer = (*timer)->next;
+            break;
+        }
+    }
+    pthread_mutex_unlock(&timer_mutex);
+    free(handle);
+    return pdPASS;
+}
+
+void* pvTimerGetTimerID(TimerHandle_t handle)
+{
+    return ((host_timer_t*)handle)->timer_id;
+}
\ No newline at end of file
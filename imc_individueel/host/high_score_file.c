@@ -0,0 +1,45 @@
+/*
+    Author: Kenley Strik
+    Addition: This whole file was written by Kenley Strik
+*/
+
+#include <stdio.h>
+#include <string.h>
+
+#include "high_score_storage.h"
+
+#define HIGH_SCORE_FILE_MAX_PATH 256        // Maximum length of the path of a record including the extension of the temporary file
+
+// Reads the [size] bytes stored under [name] into [data], returns false if nothing of that size is stored, on the host [name] is the path of the file
+bool high_score_storage_load(const char* name, void* data, size_t size)
+{
+    FILE* file = fopen(name, "rb");
+    if(file == NULL)
+        return false;
+
+    // The file has to hold exactly one record
+    bool is_read = fread(data, 1, size, file) == size && fgetc(file) == EOF;
+    fclose(file);
+    return is_read;
+}
+
+// Stores the [size] bytes at [data] under [name], returns false if they could not be stored, on the host [name] is the path of the file
+bool high_score_storage_save(const char* name, const void* data, size_t size)
+{
+    // The record is written to a temporary file that replaces the file at once, like NVS the last record is kept when writing fails
+    char path[HIGH_SCORE_FILE_MAX_PATH];
+    if(snprintf(path, sizeof(path), "%s.tmp", name) >= (int)sizeof(path))
+        return false;
+
+    FILE* file = fopen(path, "wb");
+    if(file == NULL)
+        return false;
+    bool is_written = fwrite(data, 1, size, file) == size;
+    is_written = (fclose(file) == 0) && is_written;
+    if(!is_written || rename(path, name) != 0)
+    {
+        remove(path);
+        return false;
+    }
+    return true;
+}
\ No newline at end of file
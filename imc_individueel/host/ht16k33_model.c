@@ -0,0 +1,235 @@
+/*
+    Author: Kenley Strik
+    Addition: This whole file was written by Kenley Strik
+*/
+
+#include <stdio.h>
+#include <stdarg.h>
+#include <string.h>
+
+#include "ht16k33_model.h"
+
+static const uint8_t HT16K33_MODEL_DISPLAY_RAM = 0x00;     // Commands 0x00 to 0x0F set the display RAM address pointer
+static const uint8_t HT16K33_MODEL_SYSTEM_SETUP = 0x20;    // Command 0x20 | S turns the oscillator on (1) or off (0)
+static const uint8_t HT16K33_MODEL_KEYSCAN_RAM = 0x40;     // Commands 0x40 to 0x45 set the key data RAM address pointer
+static const uint8_t HT16K33_MODEL_INTERRUPT_FLAG = 0x60;  // Command 0x60 sets the address pointer to the interrupt flag
+static const uint8_t HT16K33_MODEL_DISPLAY_SETUP = 0x80;   // Command 0x80 | blink << 1 | D sets the blink rate and turns the display on or off
+static const uint8_t HT16K33_MODEL_ROW_INT_SET = 0xA0;     // Command 0xA0 | ACT << 1 | ROW/INT configures the ROW/INT pin
+static const uint8_t HT16K33_MODEL_DIMMING_SET = 0xE0;     // Command 0xE0 | level sets the dimming level
+static const uint8_t HT16K33_MODEL_POWER_ON_BRIGHTNESS = 15;   // Dimming level of the chip after power on
+
+// Counts a protocol misuse and keeps its description for the test that caused it
+static void ht16k33_model_report_misuse(ht16k33_model_t* model, const char* format, ...)
+{
+    va_list args;
+    va_start(args, format);
+    vsnprintf(model->last_misuse, HT16K33_MODEL_MAX_MISUSE_LENGTH, format, args);
+    va_end(args);
+    model->misuse_count++;
+}
+
+// Decodes the first byte of a write transaction, every command except the address pointer commands is a single byte
+static void ht16k33_model_decode_command(ht16k33_model_t* model, uint8_t command)
+{
+    uint8_t group = command & 0xF0;
+    uint8_t parameter = command & 0x0F;
+    if(group == HT16K33_MODEL_DISPLAY_RAM)
+        model->pointer = command;
+    else if(group == HT16K33_MODEL_SYSTEM_SETUP)
+    {
+        model->commands++;
+        if(model->is_oscillator_on == (bool)(parameter & 0x01))
+            model->redundant_commands++;
+        model->is_oscillator_on = parameter & 0x01;
+    }
+    else if(group == HT16K33_MODEL_KEYSCAN_RAM)
+    {
+        if(parameter >= HT16K33_MODEL_KEYSCAN_RAM_SIZE)
+            ht16k33_model_report_misuse(model, "key data RAM address 0x%02X does not exist", command);
+        model->pointer = command;
+    }
+    else if(group == HT16K33_MODEL_INTERRUPT_FLAG)
+    {
+        if(parameter != 0)
+            ht16k33_model_report_misuse(model, "invalid command 0x%02X", command);
+        model->pointer = HT16K33_MODEL_INTERRUPT_FLAG;
+    }
+    else if(group == HT16K33_MODEL_DISPLAY_SETUP)
+    {
+        model->commands++;
+        if(model->blink == ((parameter >> 1) & 0x03) && model->is_display_on == (bool)(parameter & 0x01))
+            model->redundant_commands++;
+        model->blink = (parameter >> 1) & 0x03;
+        model->is_display_on = parameter & 0x01;
+    }
+    else if(group == HT16K33_MODEL_ROW_INT_SET)
+    {
+        model->commands++;
+        if(model->row_int == parameter)
+            model->redundant_commands++;
+        model->row_int = parameter;
+    }
+    else if(group == HT16K33_MODEL_DIMMING_SET)
+    {
+        model->commands++;
+        if(model->brightness == parameter)
+            model->redundant_commands++;
+        model->brightness = parameter;
+    }
+    else
+        ht16k33_model_report_misuse(model, "invalid command 0x%02X", command);
+}
+
+// Called by the host I2C bus when the chip is addressed by a (repeated) start
+static bool ht16k33_model_start(void* context, bool is_read)
+{
+    ht16k33_model_t* model = (ht16k33_model_t*)context;
+    if(!model->is_connected)
+        return false;
+
+    model->transactions++;
+    model->transaction_bytes = 0;
+    return true;
+}
+
+// Called by the host I2C bus for every byte written to the chip
+static bool ht16k33_model_write(void* context, uint8_t data)
+{
+    ht16k33_model_t* model = (ht16k33_model_t*)context;
+    if(model->transaction_bytes++ == 0)
+    {
+        model->command = data;
+        ht16k33_model_decode_command(model, data);
+        return true;
+    }
+
+    if((model->command & 0xF0) == HT16K33_MODEL_DISPLAY_RAM)
+    {
+        // Display RAM writes auto-increment the pointer, the chip wraps back to address 0x00 after 0x0F
+        if(model->transaction_bytes == HT16K33_MODEL_DISPLAY_RAM_SIZE - (model->command & 0x0F) + 2)
+            ht16k33_model_report_misuse(model, "display RAM write starting at 0x%02X wrapped past 0x0F", model->command);
+
+        model->ram_writes++;
+        if(model->display_ram[model->pointer] == data)
+            model->redundant_ram_writes++;
+        model->display_ram[model->pointer] = data;
+        model->pointer = (model->pointer + 1) & 0x0F;
+    }
+    else if(model->transaction_bytes == 2)
+    {
+        // Report a transaction only once, the chip ignores the remaining bytes just the same
+        if((model->command & 0xF0) == HT16K33_MODEL_KEYSCAN_RAM || (model->command & 0xF0) == HT16K33_MODEL_INTERRUPT_FLAG)
+            ht16k33_model_report_misuse(model, "write to read-only address 0x%02X", model->command);
+        else
+            ht16k33_model_report_misuse(model, "data byte 0x%02X after single byte command 0x%02X", data, model->command);
+    }
+    return true;
+}
+
+// Called by the host I2C bus for every byte read from the chip, reads continue at the address pointer of the last write
+static uint8_t ht16k33_model_read(void* context)
+{
+    ht16k33_model_t* model = (ht16k33_model_t*)context;
+    uint8_t data = 0x00;
+    if(model->pointer < HT16K33_MODEL_DISPLAY_RAM_SIZE)
+    {
+        data = model->display_ram[model->pointer];
+        model->pointer = (model->pointer + 1) & 0x0F;
+    }
+    else if(model->pointer >= HT16K33_MODEL_KEYSCAN_RAM && model->pointer < HT16K33_MODEL_KEYSCAN_RAM + HT16K33_MODEL_KEYSCAN_RAM_SIZE)
+    {
+        data = model->keyscan_ram[model->pointer - HT16K33_MODEL_KEYSCAN_RAM];
+        if(++model->pointer == HT16K33_MODEL_KEYSCAN_RAM + HT16K33_MODEL_KEYSCAN_RAM_SIZE)
+            model->pointer = HT16K33_MODEL_KEYSCAN_RAM;
+    }
+    else if(model->pointer == HT16K33_MODEL_INTERRUPT_FLAG)
+        data = model->is_interrupt_flag ? 0xFF : 0x00;
+    else
+        ht16k33_model_report_misuse(model, "read from address 0x%02X", model->pointer);
+    return data;
+}
+
+// Called by the host I2C bus when the transaction addressed to the chip ends
+static void ht16k33_model_stop(void* context)
+{
+    ht16k33_model_t* model = (ht16k33_model_t*)context;
+    model->transaction_bytes = 0;
+}
+
+// Initializes the model with the power on state of the chip and I2C address [address]
+void ht16k33_model_init(ht16k33_model_t* model, uint8_t address)
+{
+    memset(model, 0, sizeof(ht16k33_model_t));
+    model->device.address = address;
+    model->device.context = model;
+    model->device.start = &ht16k33_model_start;
+    model->device.write = &ht16k33_model_write;
+    model->device.read = &ht16k33_model_read;
+    model->device.stop = &ht16k33_model_stop;
+    model->is_connected = true;
+    ht16k33_model_power_cycle(model);
+}
+
+// Attaches the model to host I2C bus [port]
+void ht16k33_model_attach(ht16k33_model_t* model, i2c_port_t port)
+{
+    i2c_host_attach_device(port, &model->device);
+}
+
+// Connects or disconnects the chip, a disconnected chip loses its power and comes back in the power on state
+void ht16k33_model_set_connected(ht16k33_model_t* model, bool is_connected)
+{
+    if(!is_connected)
+        ht16k33_model_power_cycle(model);
+    model->is_connected = is_connected;
+}
+
+// Resets the chip to its power on state like a brown-out does
+void ht16k33_model_power_cycle(ht16k33_model_t* model)
+{
+    memset(model->display_ram, 0, HT16K33_MODEL_DISPLAY_RAM_SIZE);     // The datasheet leaves the RAM undefined, zero keeps the tests repeatable
+    memset(model->keyscan_ram, 0, HT16K33_MODEL_KEYSCAN_RAM_SIZE);
+    model->is_interrupt_flag = false;
+    model->is_oscillator_on = false;
+    model->is_display_on = false;
+    model->blink = 0;
+    model->brightness = HT16K33_MODEL_POWER_ON_BRIGHTNESS;
+    model->row_int = 0;
+    model->pointer = 0;
+    model->transaction_bytes = 0;
+}
+
+// Resets the traffic and misuse counters
+void ht16k33_model_reset_stats(ht16k33_model_t* model)
+{
+    model->transactions = 0;
+    model->commands = 0;
+    model->ram_writes = 0;
+    model->redundant_commands = 0;
+    model->redundant_ram_writes = 0;
+    model->misuse_count = 0;
+    model->last_misuse[0] = '\0';
+}
+
+// Returns the value display RAM holds for the pixel at [x, y], the modules are wired with the columns rotated one to the left
+bool ht16k33_model_get_pixel(const ht16k33_model_t* model, uint8_t x, uint8_t y)
+{
+    if(x >= 8 || y >= 8)
+        return false;
+    return (model->display_ram[y * 2] >> ((x + 7) & 7)) & 0x01;
+}
+
+// Returns row [y] of display RAM with the wiring undone, the byte is rotated one to the left
+uint8_t ht16k33_model_get_row(const ht16k33_model_t* model, uint8_t y)
+{
+    if(y >= 8)
+        return 0x00;
+    uint8_t row = model->display_ram[y * 2];
+    return (uint8_t)((row << 1) | (row >> 7));
+}
+
+// Returns true if the pixel at [x, y] is visible, it also needs the oscillator and the display to be on
+bool ht16k33_model_is_pixel_lit(const ht16k33_model_t* model, uint8_t x, uint8_t y)
+{
+    return model->is_oscillator_on && model->is_display_on && ht16k33_model_get_pixel(model, x, y);
+}
\ No newline at end of file
@@ -0,0 +1,344 @@
+/*
+    Author: Kenley Strik
+    Addition: This whole file was written by Kenley Strik
+*/
+
+#define _GNU_SOURCE
+
+#include <pthread.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <errno.h>
+
+#include "driver/i2c.h"
+#include "i2c_host.h"
+
+static const uint32_t I2C_HOST_DEFAULT_CLOCK_SPEED = 100000;     // Clock speed of a bus that was not configured
+static const int I2C_HOST_BITS_PER_BYTE = 9;                    // Bits on the bus for every byte, 8 data bits and the acknowledge bit
+static const int I2C_HOST_BITS_PER_CONDITION = 1;               // Bits on the bus for a start or stop condition
+
+// Enumerator for the different operations of a command link
+typedef enum
+{
+    I2C_HOST_OP_START,
+    I2C_HOST_OP_WRITE,
+    I2C_HOST_OP_READ,
+    I2C_HOST_OP_STOP
+} i2c_host_op_type_t;
+
+// Type for representing one operation of a command link
+typedef struct i2c_host_op
+{
+    struct i2c_host_op* next;               // Next operation of the command link
+    i2c_host_op_type_t type;                // Type of the operation
+    uint8_t* data;                          // Bytes to write, or location to read the bytes to
+    size_t length;                          // Ammount of bytes of the operation
+    bool is_ack_checked;                    // Boolean value for indicating if a write fails when the device does not acknowledge
+    i2c_ack_type_t ack;                     // Acknowledge the master gives after the bytes of a read
+    uint8_t byte;                           // Storage for a single byte write, so the caller does not have to keep it
+} i2c_host_op_t;
+
+// Type for representing a command link, the operations are played against the bus in i2c_master_cmd_begin
+typedef struct
+{
+    i2c_host_op_t* first;                   // First operation of the command link
+    i2c_host_op_t* last;                    // Last operation of the command link
+} i2c_host_cmd_t;
+
+// Type for representing a host I2C bus
+typedef struct
+{
+    i2c_host_device_t* devices[I2C_HOST_MAX_DEVICES];  // Devices attached to the bus
+    uint32_t clock_speed;                   // Clock speed of the bus in Hz
+    bool is_installed;                      // Boolean value for indicating if the driver of the bus is installed
+    i2c_host_stats_t stats;                 // Traffic of the bus since the last reset
+} i2c_host_bus_t;
+
+static i2c_host_bus_t buses[I2C_NUM_MAX];
+static pthread_mutex_t bus_mutex = PTHREAD_MUTEX_INITIALIZER;
+static bool is_realtime = false;
+
+// Returns the device with address [address] on [bus] or NULL if no device answers to it
+static i2c_host_device_t* i2c_host_find_device(i2c_host_bus_t* bus, uint8_t address)
+{
+    for(int i = 0; i < I2C_HOST_MAX_DEVICES; i++)
+    {
+        if(bus->devices[i] != NULL && bus->devices[i]->address == address)
+            return bus->devices[i];
+    }
+    return NULL;
+}
+
+// Attaches [device] to bus [port], the device stays owned by the caller
+void i2c_host_attach_device(i2c_port_t port, i2c_host_device_t* device)
+{
+    pthread_mutex_lock(&bus_mutex);
+    for(int i = 0; i < I2C_HOST_MAX_DEVICES; i++)
+    {
+        if(buses[port].devices[i] == NULL)
+        {
+            buses[port].devices[i] = device;
+            break;
+        }
+    }
+    pthread_mutex_unlock(&bus_mutex);
+}
+
+// Detaches the device with address [address] from bus [port]
+void i2c_host_detach_device(i2c_port_t port, uint8_t address)
+{
+    pthread_mutex_lock(&bus_mutex);
+    for(int i = 0; i < I2C_HOST_MAX_DEVICES; i++)
+    {
+        if(buses[port].devices[i] != NULL && buses[port].devices[i]->address == address)
+            buses[port].devices[i] = NULL;
+    }
+    pthread_mutex_unlock(&bus_mutex);
+}
+
+// Sets if a transaction takes as long as it would take on a real bus, so timing sensitive code can be measured
+void i2c_host_set_realtime(bool realtime)
+{
+    is_realtime = realtime;
+}
+
+// Returns the traffic of bus [port] since the last reset
+i2c_host_stats_t i2c_host_get_stats(i2c_port_t port)
+{
+    pthread_mutex_lock(&bus_mutex);
+    i2c_host_stats_t stats = buses[port].stats;
+    pthread_mutex_unlock(&bus_mutex);
+    return stats;
+}
+
+// Resets the traffic counters of bus [port]
+void i2c_host_reset_stats(i2c_port_t port)
+{
+    pthread_mutex_lock(&bus_mutex);
+    memset(&buses[port].stats, 0, sizeof(i2c_host_stats_t));
+    pthread_mutex_unlock(&bus_mutex);
+}
+
+esp_err_t i2c_param_config(i2c_port_t i2c_num, const i2c_config_t* i2c_conf)
+{
+    if(i2c_num >= I2C_NUM_MAX || i2c_conf == NULL || i2c_conf->mode != I2C_MODE_MASTER)
+        return ESP_ERR_INVALID_ARG;
+
+    buses[i2c_num].clock_speed = i2c_conf->master.clk_speed;
+    return ESP_OK;
+}
+
+esp_err_t i2c_driver_install(i2c_port_t i2c_num, i2c_mode_t mode, size_t slv_rx_buf_len, size_t slv_tx_buf_len, int intr_alloc_flags)
+{
+    if(i2c_num >= I2C_NUM_MAX)
+        return ESP_ERR_INVALID_ARG;
+    if(buses[i2c_num].is_installed)
+        return ESP_FAIL;
+
+    buses[i2c_num].is_installed = true;
+    return ESP_OK;
+}
+
+esp_err_t i2c_driver_delete(i2c_port_t i2c_num)
+{
+    if(i2c_num >= I2C_NUM_MAX)
+        return ESP_ERR_INVALID_ARG;
+
+    buses[i2c_num].is_installed = false;
+    return ESP_OK;
+}
+
+esp_err_t i2c_set_timeout(i2c_port_t i2c_num, int timeout)
+{
+    return (i2c_num < I2C_NUM_MAX) ? ESP_OK : ESP_ERR_INVALID_ARG;
+}
+
+i2c_cmd_handle_t i2c_cmd_link_create(void)
+{
+    return calloc(1, sizeof(i2c_host_cmd_t));
+}
+
+void i2c_cmd_link_delete(i2c_cmd_handle_t cmd_handle)
+{
+    i2c_host_cmd_t* cmd = (i2c_host_cmd_t*)cmd_handle;
+    if(cmd == NULL)
+        return;
+
+    i2c_host_op_t* op = cmd->first;
+    while(op != NULL)
+    {
+        i2c_host_op_t* next = op->next;
+        free(op);
+        op = next;
+    }
+    free(cmd);
+}
+
+// Appends an operation of [type] to command link [cmd_handle] and returns it
+static i2c_host_op_t* i2c_host_add_op(i2c_cmd_handle_t cmd_handle, i2c_host_op_type_t type)
+{
+    i2c_host_cmd_t* cmd = (i2c_host_cmd_t*)cmd_handle;
+    i2c_host_op_t* op = (i2c_host_op_t*)calloc(1, sizeof(i2c_host_op_t));
+    if(op == NULL)
+        return NULL;
+    op->type = type;
+
+    if(cmd->last == NULL)
+        cmd->first = op;
+    else
+        cmd->last->next = op;
+    cmd->last = op;
+    return op;
+}
+
+esp_err_t i2c_master_start(i2c_cmd_handle_t cmd_handle)
+{
+    return (i2c_host_add_op(cmd_handle, I2C_HOST_OP_START) != NULL) ? ESP_OK : ESP_ERR_NO_MEM;
+}
+
+esp_err_t i2c_master_write_byte(i2c_cmd_handle_t cmd_handle, uint8_t data, bool ack_en)
+{
+    i2c_host_op_t* op = i2c_host_add_op(cmd_handle, I2C_HOST_OP_WRITE);
+    if(op == NULL)
+        return ESP_ERR_NO_MEM;
+
+    op->byte = data;
+    op->data = &op->byte;
+    op->length = 1;
+    op->is_ack_checked = ack_en;
+    return ESP_OK;
+}
+
+esp_err_t i2c_master_write(i2c_cmd_handle_t cmd_handle, uint8_t* data, size_t data_len, bool ack_en)
+{
+    i2c_host_op_t* op = i2c_host_add_op(cmd_handle, I2C_HOST_OP_WRITE);
+    if(op == NULL)
+        return ESP_ERR_NO_MEM;
+
+    op->data = data;
+    op->length = data_len;
+    op->is_ack_checked = ack_en;
+    return ESP_OK;
+}
+
+esp_err_t i2c_master_read_byte(i2c_cmd_handle_t cmd_handle, uint8_t* data, i2c_ack_type_t ack)
+{
+    return i2c_master_read(cmd_handle, data, 1, ack);
+}
+
+esp_err_t i2c_master_read(i2c_cmd_handle_t cmd_handle, uint8_t* data, size_t data_len, i2c_ack_type_t ack)
+{
+    i2c_host_op_t* op = i2c_host_add_op(cmd_handle, I2C_HOST_OP_READ);
+    if(op == NULL)
+        return ESP_ERR_NO_MEM;
+
+    op->data = data;
+    op->length = data_len;
+    op->ack = ack;
+    return ESP_OK;
+}
+
+esp_err_t i2c_master_stop(i2c_cmd_handle_t cmd_handle)
+{
+    return (i2c_host_add_op(cmd_handle, I2C_HOST_OP_STOP) != NULL) ? ESP_OK : ESP_ERR_NO_MEM;
+}
+
+/*
+    Plays the operations of command link [cmd_handle] against the devices on bus [i2c_num]. The first byte after a start
+    is the address byte, every byte after it goes to the addressed device until the next start or the stop. A byte
+    that is not acknowledged fails the transaction with ESP_FAIL, like the hardware driver does
+*/
+esp_err_t i2c_master_cmd_begin(i2c_port_t i2c_num, i2c_cmd_handle_t cmd_handle, TickType_t ticks_to_wait)
+{
+    if(i2c_num >= I2C_NUM_MAX || cmd_handle == NULL)
+        return ESP_ERR_INVALID_ARG;
+
+    pthread_mutex_lock(&bus_mutex);
+    i2c_host_bus_t* bus = &buses[i2c_num];
+    if(!bus->is_installed)
+    {
+        pthread_mutex_unlock(&bus_mutex);
+        return ESP_ERR_INVALID_STATE;
+    }
+
+    esp_err_t result = ESP_OK;
+    i2c_host_device_t* device = NULL;       // Device addressed by the last start, NULL if no device acknowledged it
+    bool is_address_next = false;           // Boolean value for indicating if the next written byte is an address byte
+    unsigned long bits = 0;                 // Ammount of clock cycles of the transaction
+
+    for(i2c_host_op_t* op = ((i2c_host_cmd_t*)cmd_handle)->first; op != NULL && result == ESP_OK; op = op->next)
+    {
+        switch(op->type)
+        {
+            case I2C_HOST_OP_START:
+                bits += I2C_HOST_BITS_PER_CONDITION;
+                is_address_next = true;
+                break;
+
+            case I2C_HOST_OP_WRITE:
+                for(size_t i = 0; i < op->length && result == ESP_OK; i++)
+                {
+                    bits += I2C_HOST_BITS_PER_BYTE;
+                    bus->stats.bytes++;
+                    bool is_acknowledged = false;
+                    if(is_address_next)
+                    {
+                        // Address byte, a repeated start to the same device does not end its transaction
+                        i2c_host_device_t* addressed = i2c_host_find_device(bus, op->data[i] >> 1);
+                        if(device != NULL && device != addressed)
+                            device->stop(device->context);
+                        device = addressed;
+                        is_acknowledged = device != NULL && device->start(device->context, op->data[i] & I2C_MASTER_READ);
+                        if(!is_acknowledged && device != NULL)
+                        {
+                            device->stop(device->context);
+                            device = NULL;
+                        }
+                        is_address_next = false;
+                    }
+                    else if(device != NULL)
+                        is_acknowledged = device->write(device->context, op->data[i]);
+
+                    if(!is_acknowledged && op->is_ack_checked)
+                        result = ESP_FAIL;
+                }
+                break;
+
+            case I2C_HOST_OP_READ:
+                for(size_t i = 0; i < op->length; i++)
+                {
+                    bits += I2C_HOST_BITS_PER_BYTE;
+                    bus->stats.bytes++;
+                    op->data[i] = (device != NULL) ? device->read(device->context) : 0xFF;     // Nobody drives the bus, the pull-ups read as ones
+                }
+                break;
+
+            case I2C_HOST_OP_STOP:
+                bits += I2C_HOST_BITS_PER_CONDITION;
+                if(device != NULL)
+                    device->stop(device->context);
+                device = NULL;
+                break;
+        }
+    }
+
+    // A failed transaction still ends with a stop condition on the bus
+    if(device != NULL)
+        device->stop(device->context);
+
+    uint32_t clock_speed = (bus->clock_speed > 0) ? bus->clock_speed : I2C_HOST_DEFAULT_CLOCK_SPEED;
+    int64_t bus_time = (int64_t)bits * 1000000 / clock_speed;
+    bus->stats.transactions++;
+    bus->stats.bus_time += bus_time;
+    if(result != ESP_OK)
+        bus->stats.nacks++;
+    pthread_mutex_unlock(&bus_mutex);
+
+    if(is_realtime)
+    {
+        struct timespec time = { bus_time / 1000000, (bus_time % 1000000) * 1000 };
+        while(nanosleep(&time, &time) == -1 && errno == EINTR);
+    }
+    return result;
+}
\ No newline at end of file
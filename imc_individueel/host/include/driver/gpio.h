@@ -0,0 +1,26 @@
+/*
+    Author: Kenley Strik
+    Addition: This whole file was written by Kenley Strik
+*/
+
+#ifndef HOST_DRIVER_GPIO_H
+#define HOST_DRIVER_GPIO_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// Only the types the I2C configuration needs, the host has no pins
+typedef int gpio_num_t;
+
+typedef enum
+{
+    GPIO_PULLUP_DISABLE = 0x0,
+    GPIO_PULLUP_ENABLE = 0x1
+} gpio_pullup_t;
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif  // HOST_DRIVER_GPIO_H
\ No newline at end of file
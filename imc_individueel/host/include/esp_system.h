@@ -0,0 +1,22 @@
+/*
+    Author: Kenley Strik
+    Addition: This whole file was written by Kenley Strik
+*/
+
+#ifndef HOST_ESP_SYSTEM_H
+#define HOST_ESP_SYSTEM_H
+
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// Random number from the random generator of the host instead of the hardware random number generator
+uint32_t esp_random(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif  // HOST_ESP_SYSTEM_H
\ No newline at end of file
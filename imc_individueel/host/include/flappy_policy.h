@@ -0,0 +1,49 @@
+/*
+    Author: Kenley Strik
+    Addition: This whole file was written by Kenley Strik
+*/
+
+#ifndef FLAPPY_POLICY_H
+#define FLAPPY_POLICY_H
+
+#include <stdbool.h>
+
+#include "flappy_bird_sim.h"
+#include "pcg_random.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define FLAPPY_POLICY_RANDOM_STREAM 2           // Stream of the random generator of a policy, the openings of a game seeded alike come from another stream
+
+// Ways of playing a simulated game
+typedef enum
+{
+    FLAPPY_POLICY_AUTOPILOT,                // Flaps when the bird falls below the middle of the next opening
+    FLAPPY_POLICY_NOISY,                    // Plays like the autopilot but sometimes misses a flap or flaps when it should not, like a person
+    FLAPPY_POLICY_RANDOM,                   // Flaps at random, the lower bound of how hard the game is
+    FLAPPY_POLICY_COUNT
+} flappy_policy_type_t;
+
+// Type for representing the player of a simulated game, the policy has its own random generator so games do not share one
+typedef struct
+{
+    flappy_policy_type_t type;              // Way the game is played
+    pcg_random_t random;                    // Random generator of the policy
+} flappy_policy_t;
+
+// Initializes the policy given to the function to play with [type] and its random generator at [seed]
+void flappy_policy_init(flappy_policy_t* policy, flappy_policy_type_t type, unsigned int seed);
+// Returns true if the policy flaps during the next step of [sim]
+bool flappy_policy_decide(flappy_policy_t* policy, const flappy_bird_sim_t* sim);
+// Returns the name of [type], or NULL if there is no such policy
+const char* flappy_policy_get_name(flappy_policy_type_t type);
+// Returns the policy called [name], or FLAPPY_POLICY_COUNT if there is no such policy
+flappy_policy_type_t flappy_policy_from_name(const char* name);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif  // FLAPPY_POLICY_H
\ No newline at end of file
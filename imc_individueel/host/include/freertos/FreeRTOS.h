@@ -0,0 +1,51 @@
+/*
+    Author: Kenley Strik
+    Addition: This whole file was written by Kenley Strik
+*/
+
+#ifndef HOST_FREERTOS_H
+#define HOST_FREERTOS_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// Types of the FreeRTOS kernel as the components use them, the kernel objects are implemented on POSIX threads by freertos_host.c
+typedef int BaseType_t;
+typedef unsigned int UBaseType_t;
+typedef uint32_t TickType_t;
+typedef uint32_t EventBits_t;
+typedef void* TaskHandle_t;
+typedef void* SemaphoreHandle_t;
+typedef void* EventGroupHandle_t;
+typedef void* TimerHandle_t;
+typedef void (*TaskFunction_t)(void*);
+typedef void (*TimerCallbackFunction_t)(TimerHandle_t);
+
+#define pdTRUE 1
+#define pdFALSE 0
+#define pdPASS 1
+#define pdFAIL 0
+#define portMAX_DELAY 0xFFFFFFFFu
+
+#define configTICK_RATE_HZ 100             // Same tick rate as the sdkconfig of the application
+#define portTICK_PERIOD_MS (1000 / configTICK_RATE_HZ)
+#define portTICK_RATE_MS portTICK_PERIOD_MS
+#define pdMS_TO_TICKS(ms) ((TickType_t)(((TickType_t)(ms) * configTICK_RATE_HZ) / 1000))
+
+#define portNUM_PROCESSORS 2
+#define PRO_CPU_NUM 0
+#define APP_CPU_NUM 1
+#define tskNO_AFFINITY 0x7FFFFFFF
+#define tskIDLE_PRIORITY 0
+#define configMAX_PRIORITIES 25
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif  // HOST_FREERTOS_H
\ No newline at end of file
@@ -0,0 +1,34 @@
+/*
+    Author: Kenley Strik
+    Addition: This whole file was written by Kenley Strik
+*/
+
+#ifndef HOST_FREERTOS_TASK_H
+#define HOST_FREERTOS_TASK_H
+
+#include "freertos/FreeRTOS.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// Tasks are POSIX threads, the stack size, priority and core are ignored
+BaseType_t xTaskCreate(TaskFunction_t function, const char* name, uint32_t stack_size, void* parameter, UBaseType_t priority, TaskHandle_t* handle);
+BaseType_t xTaskCreatePinnedToCore(TaskFunction_t function, const char* name, uint32_t stack_size, void* parameter, UBaseType_t priority, TaskHandle_t* handle, BaseType_t core_id);
+void vTaskDelete(TaskHandle_t handle);
+TaskHandle_t xTaskGetCurrentTaskHandle(void);
+
+// Ticks follow the monotonic clock of the host
+void vTaskDelay(TickType_t ticks);
+void vTaskDelayUntil(TickType_t* previous_wake_time, TickType_t increment);
+TickType_t xTaskGetTickCount(void);
+
+// Task notifications used as a counting semaphore
+BaseType_t xTaskNotifyGive(TaskHandle_t handle);
+uint32_t ulTaskNotifyTake(BaseType_t clear_on_exit, TickType_t ticks_to_wait);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif  // HOST_FREERTOS_TASK_H
\ No newline at end of file
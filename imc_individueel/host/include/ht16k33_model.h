@@ -0,0 +1,76 @@
+/*
+    Author: Kenley Strik
+    Addition: This whole file was written by Kenley Strik
+*/
+
+#ifndef HT16K33_MODEL_H
+#define HT16K33_MODEL_H
+
+#include <stdint.h>
+#include <stdbool.h>
+
+#include "driver/i2c.h"
+#include "i2c_host.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define HT16K33_MODEL_DISPLAY_RAM_SIZE 16   // Bytes of display RAM, two bytes for each of the 8 rows
+#define HT16K33_MODEL_KEYSCAN_RAM_SIZE 6    // Bytes of key data RAM
+#define HT16K33_MODEL_MAX_MISUSE_LENGTH 96  // Maximum length of the description of the last protocol misuse
+
+/*
+    Type for representing a virtual HT16K33 on a host I2C bus. It decodes the commands and display RAM writes like
+    the chip does, and counts the traffic it receives and every byte that did not change anything or breaks the protocol
+*/
+typedef struct
+{
+    i2c_host_device_t device;               // Device the model is attached to a host I2C bus with
+    bool is_connected;                      // Boolean value for indicating if the chip is on the bus, a disconnected chip does not acknowledge
+
+    uint8_t display_ram[HT16K33_MODEL_DISPLAY_RAM_SIZE];   // Display RAM, row y is at address 2 * y
+    uint8_t keyscan_ram[HT16K33_MODEL_KEYSCAN_RAM_SIZE];   // Key data RAM at addresses 0x40 to 0x45
+    bool is_interrupt_flag;                 // Interrupt flag at address 0x60, set when a key is pressed
+    bool is_oscillator_on;                  // Boolean value for indicating if the system oscillator runs, the chip is in standby otherwise
+    bool is_display_on;                     // Boolean value for indicating if the display is turned on
+    uint8_t blink;                          // Blink rate, 0 is off and 1 to 3 are 2 Hz, 1 Hz and 0.5 Hz
+    uint8_t brightness;                     // Dimming level, 0 (1/16 duty) to 15 (16/16 duty)
+    uint8_t row_int;                        // ROW/INT setting
+
+    uint8_t pointer;                        // Address pointer for display RAM, key data RAM and interrupt flag accesses
+    uint8_t command;                        // First byte of the running write transaction
+    unsigned int transaction_bytes;         // Ammount of bytes written in the running transaction
+
+    unsigned long transactions;             // Ammount of transactions addressed to the chip
+    unsigned long commands;                 // Ammount of single byte commands
+    unsigned long ram_writes;               // Ammount of bytes written to display RAM
+    unsigned long redundant_commands;       // Ammount of commands that set the state the chip already had
+    unsigned long redundant_ram_writes;     // Ammount of display RAM bytes written with the value they already had
+    unsigned long misuse_count;             // Ammount of protocol misuses
+    char last_misuse[HT16K33_MODEL_MAX_MISUSE_LENGTH];     // Description of the last protocol misuse
+} ht16k33_model_t;
+
+// Initializes the model with the power on state of the chip and I2C address [address]
+void ht16k33_model_init(ht16k33_model_t* model, uint8_t address);
+// Attaches the model to host I2C bus [port]
+void ht16k33_model_attach(ht16k33_model_t* model, i2c_port_t port);
+// Connects or disconnects the chip, a disconnected chip loses its power and comes back in the power on state
+void ht16k33_model_set_connected(ht16k33_model_t* model, bool is_connected);
+// Resets the chip to its power on state like a brown-out does
+void ht16k33_model_power_cycle(ht16k33_model_t* model);
+// Resets the traffic and misuse counters
+void ht16k33_model_reset_stats(ht16k33_model_t* model);
+
+// Returns the value display RAM holds for the pixel at [x, y], with the wiring of the matrix modules of the game
+bool ht16k33_model_get_pixel(const ht16k33_model_t* model, uint8_t x, uint8_t y);
+// Returns row [y] of display RAM with the wiring undone, so bit x is the pixel at x like in the rows of a matrix display
+uint8_t ht16k33_model_get_row(const ht16k33_model_t* model, uint8_t y);
+// Returns true if the pixel at [x, y] is visible, it also needs the oscillator and the display to be on
+bool ht16k33_model_is_pixel_lit(const ht16k33_model_t* model, uint8_t x, uint8_t y);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif  // HT16K33_MODEL_H
\ No newline at end of file
@@ -0,0 +1,58 @@
+/*
+    Author: Kenley Strik
+    Addition: This whole file was written by Kenley Strik
+*/
+
+#ifndef I2C_HOST_H
+#define I2C_HOST_H
+
+#include <stdint.h>
+#include <stdbool.h>
+
+#include "driver/i2c.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define I2C_HOST_MAX_DEVICES 16            // Maximum ammount of devices that can be attached to one bus
+
+/*
+    Type for representing a device model on a host I2C bus, the bus calls the functions for every condition and byte
+    of a transaction that is addressed to the device, like the pins of a real device would see them
+*/
+typedef struct
+{
+    uint8_t address;                                // 7-bit I2C address of the device
+    void* context;                                  // Pointer that is passed to every function of the device
+    bool (*start)(void* context, bool is_read);     // Called after the device was addressed by a (repeated) start, returns false to not acknowledge
+    bool (*write)(void* context, uint8_t data);     // Called for every byte written to the device, returns false to not acknowledge
+    uint8_t (*read)(void* context);                 // Called for every byte read from the device
+    void (*stop)(void* context);                    // Called when the transaction addressed to the device ends
+} i2c_host_device_t;
+
+// Type for representing the traffic on a host I2C bus
+typedef struct
+{
+    unsigned long transactions;                     // Ammount of transactions (i2c_master_cmd_begin calls)
+    unsigned long bytes;                            // Ammount of bytes on the bus including the address bytes
+    unsigned long nacks;                            // Ammount of transactions that failed because a byte was not acknowledged
+    int64_t bus_time;                               // Time in microseconds the transactions take on a bus with the configured clock speed
+} i2c_host_stats_t;
+
+// Attaches a device model to bus [port], transactions to its address are handled by it until it is detached
+void i2c_host_attach_device(i2c_port_t port, i2c_host_device_t* device);
+// Detaches the device with address [address] from bus [port], the address is not acknowledged anymore
+void i2c_host_detach_device(i2c_port_t port, uint8_t address);
+// Makes i2c_master_cmd_begin take as long as the transaction would take on the bus with its configured clock speed
+void i2c_host_set_realtime(bool is_realtime);
+// Returns the traffic on bus [port] since the last reset
+i2c_host_stats_t i2c_host_get_stats(i2c_port_t port);
+// Resets the traffic counters of bus [port]
+void i2c_host_reset_stats(i2c_port_t port);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif  // I2C_HOST_H
\ No newline at end of file
@@ -0,0 +1,350 @@
+/*
+    Author: Kenley Strik
+    Addition: This whole file was written by Kenley Strik
+*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+#include <pthread.h>
+
+#include "flappy_bird_sim.h"
+#include "flappy_policy.h"
+
+#define FLAPPY_BATCH_MAX_VALUES 16          // Maximum ammount of values of one swept setting
+#define FLAPPY_BATCH_HISTOGRAM_SIZE 256     // Ammount of scores the histogram counts separately, higher scores are counted in the last bucket
+
+// Type for representing one combination of rules and policy that is played by a batch of games
+typedef struct
+{
+    flappy_bird_sim_config_t config;        // Rules the games are played with
+    flappy_policy_type_t policy;            // Way the games are played
+    int gap;                                // Size of the openings in pixels
+    int spacing;                            // Distance between two pipelanes in pixels
+    double gravity;                         // Gravity in pixels per step per step
+} flappy_batch_setting_t;
+
+// Type for representing what was measured while playing one game, or the games of one setting together
+typedef struct
+{
+    unsigned long steps;                    // Ammount of steps played
+    unsigned long rounds;                   // Ammount of rounds that ended with a crash
+    unsigned long score_total;              // Sum of the scores of the rounds that ended
+    unsigned long survival_total;           // Sum of the ammount of steps from the start of every round that ended to its crash
+    unsigned int best_score;                // Highest score of a round, including the round that did not end yet
+    unsigned long histogram[FLAPPY_BATCH_HISTOGRAM_SIZE];  // Ammount of rounds that ended with every score
+} flappy_batch_result_t;
+
+// Type for representing the jobs a worker has not started yet, the worker takes from the back and other workers steal from the front
+typedef struct
+{
+    pthread_mutex_t lock;                   // Lock guarding the range of jobs
+    unsigned long head;                     // First job that was not taken yet
+    unsigned long tail;                     // One past the last job that was not taken yet
+    unsigned long steal_count;              // Ammount of times the worker stole jobs from another worker
+} flappy_batch_queue_t;
+
+// Type for representing a batch of games, job j is game (j % game_count) of setting (j / game_count)
+typedef struct
+{
+    flappy_batch_setting_t* settings;       // Settings that are played
+    unsigned int setting_count;             // Ammount of settings
+    unsigned int game_count;                // Ammount of games played with every setting
+    unsigned long steps_per_game;           // Ammount of steps every game is played for
+    unsigned int seed;                      // Seed of the first game of every setting, game i is played with seed + i
+    flappy_batch_result_t* results;         // Result of every job
+    flappy_batch_queue_t* queues;           // Queue of every worker
+    unsigned int worker_count;              // Ammount of worker threads
+} flappy_batch_t;
+
+// Type for representing the argument of a worker thread
+typedef struct
+{
+    flappy_batch_t* batch;                  // Batch the worker plays games of
+    unsigned int index;                     // Index of the queue of the worker
+} flappy_batch_worker_t;
+
+// Returns the time in nanoseconds of the monotonic clock
+static int64_t flappy_batch_get_time()
+{
+    struct timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return (int64_t)now.tv_sec * 1000000000 + now.tv_nsec;
+}
+
+// Reads the comma separated numbers of [text] into [values], returns the ammount of values or 0 if [text] is not a list of at most FLAPPY_BATCH_MAX_VALUES numbers
+static unsigned int flappy_batch_parse_list(const char* text, double* values)
+{
+    unsigned int count = 0;
+    const char* position = text;
+    while(*position != '\0')
+    {
+        char* end = NULL;
+        double value = strtod(position, &end);
+        if(end == position || count == FLAPPY_BATCH_MAX_VALUES || (*end != ',' && *end != '\0'))
+            return 0;
+        values[count++] = value;
+        position = (*end == ',') ? end + 1 : end;
+    }
+    return count;
+}
+
+// Takes the last job of the queue of worker [index], returns false if the queue is empty
+static bool flappy_batch_take(flappy_batch_t* batch, unsigned int index, unsigned long* job)
+{
+    flappy_batch_queue_t* queue = &batch->queues[index];
+    pthread_mutex_lock(&queue->lock);
+    bool has_job = queue->head < queue->tail;
+    if(has_job)
+        *job = --queue->tail;
+    pthread_mutex_unlock(&queue->lock);
+    return has_job;
+}
+
+/*
+    Steals the first half of the jobs of another worker into the empty queue of worker [index] and takes the last of them,
+    returns false if no worker has jobs left. Games are never added, so a worker that finds nothing to steal is done
+*/
+static bool flappy_batch_steal(flappy_batch_t* batch, unsigned int index, unsigned long* job)
+{
+    for(unsigned int i = 1; i < batch->worker_count; i++)
+    {
+        flappy_batch_queue_t* victim = &batch->queues[(index + i) % batch->worker_count];
+        pthread_mutex_lock(&victim->lock);
+        unsigned long start = victim->head;
+        unsigned long count = (victim->tail - victim->head + 1) / 2;
+        victim->head += count;
+        pthread_mutex_unlock(&victim->lock);
+
+        if(count > 0)
+        {
+            flappy_batch_queue_t* queue = &batch->queues[index];
+            pthread_mutex_lock(&queue->lock);
+            queue->head = start;
+            queue->tail = start + count - 1;
+            queue->steal_count++;
+            pthread_mutex_unlock(&queue->lock);
+            *job = start + count - 1;
+            return true;
+        }
+    }
+    return false;
+}
+
+// Plays the game of [job] and stores what was measured in the result of the job
+static void flappy_batch_run(flappy_batch_t* batch, unsigned long job)
+{
+    const flappy_batch_setting_t* setting = &batch->settings[job / batch->game_count];
+    unsigned int seed = batch->seed + (unsigned int)(job % batch->game_count);   // Every setting plays the same seeds, so settings are compared on the same pipelanes
+    flappy_batch_result_t* result = &batch->results[job];
+    memset(result, 0, sizeof(flappy_batch_result_t));
+
+    flappy_bird_sim_t sim;
+    if(!flappy_bird_sim_init(&sim, &setting->config, seed))
+        return;
+    flappy_policy_t policy;
+    flappy_policy_init(&policy, setting->policy, seed);
+
+    unsigned long round_start = 0;
+    for(unsigned long i = 0; i < batch->steps_per_game; i++)
+    {
+        if(flappy_bird_sim_step(&sim, flappy_policy_decide(&policy, &sim)) & FLAPPY_BIRD_SIM_EVENT_CRASH)
+        {
+            result->rounds++;
+            result->score_total += sim.last_score;
+            result->survival_total += sim.step_count - round_start;
+            result->histogram[(sim.last_score < FLAPPY_BATCH_HISTOGRAM_SIZE) ? sim.last_score : FLAPPY_BATCH_HISTOGRAM_SIZE - 1]++;
+            if(sim.last_score > result->best_score)
+                result->best_score = sim.last_score;
+            round_start = sim.step_count;
+        }
+    }
+    result->steps = sim.step_count;
+    if(sim.score > result->best_score)
+        result->best_score = sim.score;     // A round that did not end in time still counts for the best score
+    flappy_bird_sim_deinit(&sim);
+}
+
+// Function for the worker threads, plays the games of its own queue and steals games from the other workers when it runs out
+static void* flappy_batch_worker(void* arg)
+{
+    flappy_batch_worker_t* worker = (flappy_batch_worker_t*)arg;
+    unsigned long job;
+    while(flappy_batch_take(worker->batch, worker->index, &job) || flappy_batch_steal(worker->batch, worker->index, &job))
+        flappy_batch_run(worker->batch, job);
+    return NULL;
+}
+
+// Returns the lowest score at least [fraction] of the rounds in [result] did not exceed
+static unsigned int flappy_batch_get_percentile(const flappy_batch_result_t* result, double fraction)
+{
+    unsigned long count = 0;
+    for(unsigned int score = 0; score < FLAPPY_BATCH_HISTOGRAM_SIZE; score++)
+    {
+        count += result->histogram[score];
+        if(count >= fraction * result->rounds)
+            return score;
+    }
+    return FLAPPY_BATCH_HISTOGRAM_SIZE - 1;
+}
+
+/*
+    Plays a batch of games for every combination of the swept settings on all cores and prints the scores and survival
+    times of every combination and the speed of the simulation
+    Usage: flappy_batch [-n games] [-s steps] [-t threads] [-S seed] [-g gaps] [-p spacings] [-G gravities] [-P policies]
+    The settings are comma separated lists, for example: flappy_batch -g 3,4,5 -G 0.08,0.1,0.12 -P autopilot,noisy
+*/
+int main(int argc, char** argv)
+{
+    unsigned int game_count = 64;
+    unsigned long steps_per_game = 100000;
+    long online_cores = sysconf(_SC_NPROCESSORS_ONLN);
+    unsigned int worker_count = (online_cores > 0) ? (unsigned int)online_cores : 1;
+    unsigned int seed = 1;
+    double gaps[FLAPPY_BATCH_MAX_VALUES] = { 4 }, spacings[FLAPPY_BATCH_MAX_VALUES] = { 6 }, gravities[FLAPPY_BATCH_MAX_VALUES] = { 0.1 };
+    unsigned int gap_count = 1, spacing_count = 1, gravity_count = 1;
+    flappy_policy_type_t policies[FLAPPY_POLICY_COUNT] = { FLAPPY_POLICY_AUTOPILOT, FLAPPY_POLICY_NOISY, FLAPPY_POLICY_RANDOM };
+    unsigned int policy_count = FLAPPY_POLICY_COUNT;
+
+    int option;
+    while((option = getopt(argc, argv, "n:s:t:S:g:p:G:P:")) != -1)
+    {
+        switch(option)
+        {
+            case 'n': game_count = (unsigned int)strtoul(optarg, NULL, 0); break;
+            case 's': steps_per_game = strtoul(optarg, NULL, 0); break;
+            case 't': worker_count = (unsigned int)strtoul(optarg, NULL, 0); break;
+            case 'S': seed = (unsigned int)strtoul(optarg, NULL, 0); break;
+            case 'g': gap_count = flappy_batch_parse_list(optarg, gaps); break;
+            case 'p': spacing_count = flappy_batch_parse_list(optarg, spacings); break;
+            case 'G': gravity_count = flappy_batch_parse_list(optarg, gravities); break;
+            case 'P':
+            {
+                // Read the comma separated policy names
+                policy_count = 0;
+                char* names = strdup(optarg);
+                char* save = NULL;
+                for(char* name = strtok_r(names, ",", &save); name != NULL; name = strtok_r(NULL, ",", &save))
+                {
+                    flappy_policy_type_t type = flappy_policy_from_name(name);
+                    if(type == FLAPPY_POLICY_COUNT || policy_count == FLAPPY_POLICY_COUNT)
+                    {
+                        fprintf(stderr, "unknown or repeated policy %s\n", name);
+                        return 1;
+                    }
+                    policies[policy_count++] = type;
+                }
+                free(names);
+                break;
+            }
+            default:
+                fprintf(stderr, "usage: %s [-n games] [-s steps] [-t threads] [-S seed] [-g gaps] [-p spacings] [-G gravities] [-P policies]\n", argv[0]);
+                return 1;
+        }
+    }
+    if(game_count == 0 || worker_count == 0 || gap_count == 0 || spacing_count == 0 || gravity_count == 0 || policy_count == 0)
+    {
+        fprintf(stderr, "every count and list needs at least one value\n");
+        return 1;
+    }
+
+    // Make a setting for every combination of the swept values
+    flappy_batch_t batch = { 0 };
+    batch.setting_count = gap_count * spacing_count * gravity_count * policy_count;
+    batch.game_count = game_count;
+    batch.steps_per_game = steps_per_game;
+    batch.seed = seed;
+    batch.worker_count = worker_count;
+    batch.settings = (flappy_batch_setting_t*)calloc(batch.setting_count, sizeof(flappy_batch_setting_t));
+    unsigned long job_count = (unsigned long)batch.setting_count * game_count;
+    batch.results = (flappy_batch_result_t*)calloc(job_count, sizeof(flappy_batch_result_t));
+    batch.queues = (flappy_batch_queue_t*)calloc(worker_count, sizeof(flappy_batch_queue_t));
+    if(batch.settings == NULL || batch.results == NULL || batch.queues == NULL)
+    {
+        fprintf(stderr, "not enough memory for %lu games\n", job_count);
+        return 1;
+    }
+
+    flappy_batch_setting_t* setting = batch.settings;
+    for(unsigned int g = 0; g < gap_count; g++)
+        for(unsigned int p = 0; p < spacing_count; p++)
+            for(unsigned int v = 0; v < gravity_count; v++)
+                for(unsigned int k = 0; k < policy_count; k++, setting++)
+                {
+                    flappy_bird_sim_default_config(&setting->config);
+                    setting->gap = (int)gaps[g];
+                    setting->spacing = (int)spacings[p];
+                    setting->gravity = gravities[v];
+                    setting->policy = policies[k];
+                    setting->config.opening_size = FIXED_FROM_INT(setting->gap);
+                    setting->config.pipelane_spacing = FIXED_FROM_INT(setting->spacing);
+                    setting->config.gravity = FIXED_FROM_FLOAT(setting->gravity);
+                }
+
+    // Every worker starts with an equal part of the jobs, the workers that finish first steal from the others
+    for(unsigned int i = 0; i < worker_count; i++)
+    {
+        pthread_mutex_init(&batch.queues[i].lock, NULL);
+        batch.queues[i].head = job_count * i / worker_count;
+        batch.queues[i].tail = job_count * (i + 1) / worker_count;
+    }
+
+    pthread_t* threads = (pthread_t*)calloc(worker_count, sizeof(pthread_t));
+    flappy_batch_worker_t* workers = (flappy_batch_worker_t*)calloc(worker_count, sizeof(flappy_batch_worker_t));
+    int64_t start_time = flappy_batch_get_time();
+    for(unsigned int i = 0; i < worker_count; i++)
+    {
+        workers[i] = (flappy_batch_worker_t){ &batch, i };
+        pthread_create(&threads[i], NULL, &flappy_batch_worker, &workers[i]);
+    }
+    for(unsigned int i = 0; i < worker_count; i++)
+        pthread_join(threads[i], NULL);
+    int64_t elapsed = flappy_batch_get_time() - start_time;
+
+    // Combine the results of the games of every setting
+    printf("%4s %7s %7s %-9s %9s %8s %5s %5s %5s %10s\n", "gap", "spacing", "gravity", "policy", "rounds", "mean", "p50", "p90", "best", "survival");
+    unsigned long total_steps = 0;
+    for(unsigned int s = 0; s < batch.setting_count; s++)
+    {
+        flappy_batch_result_t total = { 0 };
+        for(unsigned int i = 0; i < game_count; i++)
+        {
+            const flappy_batch_result_t* result = &batch.results[(unsigned long)s * game_count + i];
+            total.steps += result->steps;
+            total.rounds += result->rounds;
+            total.score_total += result->score_total;
+            total.survival_total += result->survival_total;
+            if(result->best_score > total.best_score)
+                total.best_score = result->best_score;
+            for(unsigned int score = 0; score < FLAPPY_BATCH_HISTOGRAM_SIZE; score++)
+                total.histogram[score] += result->histogram[score];
+        }
+        total_steps += total.steps;
+
+        setting = &batch.settings[s];
+        double rounds = (total.rounds > 0) ? (double)total.rounds : 1.0;
+        printf("%4d %7d %7.3f %-9s %9lu %8.2f %5u %5u %5u %10.1f\n", setting->gap, setting->spacing, setting->gravity,
+                flappy_policy_get_name(setting->policy), total.rounds, total.score_total / rounds,
+                flappy_batch_get_percentile(&total, 0.5), flappy_batch_get_percentile(&total, 0.9), total.best_score,
+                total.survival_total / rounds);
+    }
+
+    unsigned long steal_count = 0;
+    for(unsigned int i = 0; i < worker_count; i++)
+    {
+        steal_count += batch.queues[i].steal_count;
+        pthread_mutex_destroy(&batch.queues[i].lock);
+    }
+    double seconds = elapsed / 1e9;
+    printf("\n%lu games, %lu steps in %.3f s on %u threads (%lu steals)\n", job_count, total_steps, seconds, worker_count, steal_count);
+    printf("speed: %.1f million steps per second, %.1f per thread\n", total_steps / seconds / 1e6, total_steps / seconds / 1e6 / worker_count);
+
+    free(threads);
+    free(workers);
+    free(batch.settings);
+    free(batch.results);
+    free(batch.queues);
+    return 0;
+}
\ No newline at end of file
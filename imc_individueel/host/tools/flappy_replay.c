@@ -0,0 +1,155 @@
+/*
+    Author: Kenley Strik
+    Addition: This whole file was written by Kenley Strik
+*/
+
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "freertos/FreeRTOS.h"
+
+#include "i2c_driver.h"
+#include "matrix_array.h"
+#include "i2c_host.h"
+#include "ht16k33_model.h"
+#include "flappy_bird_replay.h"
+
+#define REPLAY_PANEL_COUNT 2                // Ammount of panels of the game, stacked vertically like on the target
+
+static const unsigned int REPLAY_DEFAULT_CLOCK_SPEED = 400000;  // I2C clock speed in Hz when it is not given on the command line
+static const unsigned int REPLAY_STEPS_PER_FRAME = 2;          // Steps between two frames, the game steps at 100 Hz and flushes at 50 Hz
+static const uint32_t REPLAY_HASH_OFFSET = 2166136261u;         // Offset basis of the 32 bit FNV-1a hash
+static const uint32_t REPLAY_HASH_PRIME = 16777619u;            // Prime of the 32 bit FNV-1a hash
+
+// Adds the 32 bit [value] to the FNV-1a [hash] one byte at a time and returns the new hash, the same hash flappy_sim prints
+static uint32_t replay_hash(uint32_t hash, uint32_t value)
+{
+    for(int i = 0; i < 4; i++)
+    {
+        hash ^= (value >> (i * 8)) & 0xFF;
+        hash *= REPLAY_HASH_PRIME;
+    }
+    return hash;
+}
+
+// Reads the whole file at [path] into memory, returns NULL if it cannot be read
+static uint8_t* replay_read_file(const char* path, size_t* size)
+{
+    FILE* file = fopen(path, "rb");
+    if(file == NULL)
+        return NULL;
+    fseek(file, 0, SEEK_END);
+    long length = ftell(file);
+    fseek(file, 0, SEEK_SET);
+    uint8_t* data = (length > 0) ? (uint8_t*)malloc((size_t)length) : NULL;
+    if(data != NULL && fread(data, 1, (size_t)length, file) != (size_t)length)
+    {
+        free(data);
+        data = NULL;
+    }
+    fclose(file);
+    *size = (size_t)length;
+    return data;
+}
+
+/*
+    Plays a replay back with the simulation of the game and shows every frame on virtual HT16K33 panels through the
+    matrix_array stack, then prints what happened in the game, the hash of its state and the bus traffic it caused.
+    Recordings made with flappy_sim print the same hash as the run they were recorded from
+    Usage: flappy_replay <replay file> [clock speed in Hz]
+*/
+int main(int argc, char** argv)
+{
+    unsigned int clock_speed = (argc > 2) ? (unsigned int)atoi(argv[2]) : REPLAY_DEFAULT_CLOCK_SPEED;
+    if(argc < 2 || clock_speed == 0)
+    {
+        fprintf(stderr, "Usage: %s <replay file> [clock speed in Hz]\n", argv[0]);
+        return 2;
+    }
+
+    size_t size = 0;
+    uint8_t* data = replay_read_file(argv[1], &size);
+    flappy_bird_player_t player;
+    if(data == NULL || !flappy_bird_player_init(&player, data, size))
+    {
+        fprintf(stderr, "%s: not a replay\n", argv[1]);
+        free(data);
+        return 2;
+    }
+    flappy_bird_sim_t sim;
+    if(!flappy_bird_player_setup(&player, &sim))
+    {
+        free(data);
+        return 1;
+    }
+
+    // Attach the panels of the game to a host bus
+    static ht16k33_model_t models[REPLAY_PANEL_COUNT];
+    matrix_array_display_address_t addresses[REPLAY_PANEL_COUNT];
+    for(int i = 0; i < REPLAY_PANEL_COUNT; i++)
+    {
+        addresses[i] = (matrix_array_display_address_t){ I2C_NUM_0, (uint8_t)(0x70 + i) };
+        ht16k33_model_init(&models[i], addresses[i].i2c_address);
+        ht16k33_model_attach(&models[i], I2C_NUM_0);
+    }
+    i2c_driver_init(I2C_NUM_0, I2C_MODE_MASTER, 23, 22, GPIO_PULLUP_ENABLE, GPIO_PULLUP_ENABLE, clock_speed);
+    matrix_array_t* array = (matrix_array_t*)malloc(sizeof(matrix_array_t));
+    array->is_initialized = false;
+    matrix_array_init(&array, VERTICAL);
+    matrix_array_add_matrix_displays(&array, addresses, REPLAY_PANEL_COUNT);
+    i2c_host_reset_stats(I2C_NUM_0);
+
+    matrix_bitmap_t bitmap;
+    matrix_bitmap_init(&bitmap, array->framebuffer.width, array->framebuffer.height);
+
+    uint32_t hash = REPLAY_HASH_OFFSET;
+    unsigned long frame_count = 0, flap_count = 0, score_count = 0;
+    unsigned int best_score = 0;
+    bool flap;
+    while(flappy_bird_player_next(&player, &flap))
+    {
+        unsigned int events = flappy_bird_sim_step(&sim, flap);
+        flap_count += flap;
+        score_count += (events & FLAPPY_BIRD_SIM_EVENT_SCORE) != 0;
+        if((events & FLAPPY_BIRD_SIM_EVENT_CRASH) && sim.last_score > best_score)
+            best_score = sim.last_score;
+
+        hash = replay_hash(hash, (uint32_t)sim.bird.yPosition);
+        hash = replay_hash(hash, (uint32_t)sim.pipelanes.xPositions[0] ^ ((uint32_t)sim.pipelanes.openingTops[0] << 16));
+        hash = replay_hash(hash, events);
+
+        // Show the frame, only the rows that changed are drawn so the traffic is what a game that draws what moved causes
+        if(sim.step_count % REPLAY_STEPS_PER_FRAME == 0)
+        {
+            flappy_bird_sim_draw(&sim, &bitmap);
+            for(int y = 0; y < (int)bitmap.height; y++)
+            {
+                uint32_t bits = matrix_bitmap_get_bits(&bitmap, 0, y, bitmap.width);
+                if(bits != matrix_array_get_row_bits(&array, 0, y, bitmap.width))
+                    matrix_array_set_row_bits(&array, 0, y, bitmap.width, bits);
+            }
+            matrix_array_update(&array);
+            frame_count++;
+        }
+    }
+
+    // The drawing of the last step is part of the hash, like in flappy_sim
+    flappy_bird_sim_draw(&sim, &bitmap);
+    for(unsigned int y = 0; y < bitmap.height; y++)
+        hash = replay_hash(hash, matrix_bitmap_get_bits(&bitmap, 0, y, bitmap.width));
+
+    i2c_host_stats_t stats = i2c_host_get_stats(I2C_NUM_0);
+    printf("replay:     %zu bytes, %lu steps, %lu flaps (seed %u)\n", size, sim.step_count, flap_count, player.seed);
+    printf("rounds:     %lu crashed, %lu openings scored, best score %u\n", sim.crash_count, score_count, best_score);
+    printf("state hash: %08x\n", hash);
+    printf("display:    %lu frames, %lu transactions, %lu bytes, %.1f ms on the bus at %u Hz\n", frame_count,
+            stats.transactions, stats.bytes, stats.bus_time / 1000.0, clock_speed);
+
+    matrix_bitmap_deinit(&bitmap);
+    flappy_bird_sim_deinit(&sim);
+    matrix_array_deinit(&array);
+    free(array);
+    i2c_driver_deinit(I2C_NUM_0);
+    free(data);
+    return 0;
+}
\ No newline at end of file
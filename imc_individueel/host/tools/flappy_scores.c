@@ -0,0 +1,72 @@
+/*
+    Author: Kenley Strik
+    Addition: This whole file was written by Kenley Strik
+*/
+
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "flappy_policy.h"
+#include "high_score.h"
+
+/*
+    Plays one session of [steps] steps of the game with a policy (the autopilot by default) and adds every round
+    to the high score table stored in [file], the same table the game keeps in NVS. Running it again with the
+    same file continues the table with a new session. Prints the table, the statistics and how many changes were
+    written together
+    Usage: flappy_scores <file> [steps] [seed] [autopilot|noisy|random]
+*/
+int main(int argc, char** argv)
+{
+    unsigned long steps = (argc > 2) ? strtoul(argv[2], NULL, 0) : 100000;
+    unsigned int seed = (argc > 3) ? (unsigned int)strtoul(argv[3], NULL, 0) : 1;
+    flappy_policy_type_t policy_type = (argc > 4) ? flappy_policy_from_name(argv[4]) : FLAPPY_POLICY_AUTOPILOT;
+    if(argc < 2 || policy_type == FLAPPY_POLICY_COUNT)
+    {
+        fprintf(stderr, "Usage: %s <file> [steps] [seed] [autopilot|noisy|random]\n", argv[0]);
+        return 2;
+    }
+
+    high_score_t scores = { .is_initialized = false };
+    if(!high_score_init(&scores, argv[1], 1, tskNO_AFFINITY))
+    {
+        fprintf(stderr, "%s: cannot start the high score table\n", argv[1]);
+        return 1;
+    }
+    high_score_begin_session(&scores);
+
+    flappy_bird_sim_config_t config;
+    flappy_bird_sim_default_config(&config);
+    flappy_bird_sim_t sim;
+    if(!flappy_bird_sim_init(&sim, &config, seed))
+        return 1;
+    flappy_policy_t policy;
+    flappy_policy_init(&policy, policy_type, seed);
+
+    // The rounds are added like the game task adds them, the table is written by its own task
+    unsigned long round_start = 0, new_entries = 0;
+    for(unsigned long i = 0; i < steps; i++)
+    {
+        if(flappy_bird_sim_step(&sim, flappy_policy_decide(&policy, &sim)) & FLAPPY_BIRD_SIM_EVENT_CRASH)
+        {
+            new_entries += high_score_submit(&scores, sim.last_score, (uint32_t)(sim.step_count - round_start)) >= 0;
+            round_start = sim.step_count;
+        }
+    }
+    flappy_bird_sim_deinit(&sim);
+
+    high_score_record_t record;
+    high_score_get_record(&scores, &record);
+    high_score_deinit(&scores);     // Writes what the task did not write yet
+
+    printf("session %u:  %u rounds, mean score %.2f, best score %u, %u rounds made the table (%s)\n", record.session_count, record.session.rounds,
+            (record.session.rounds > 0) ? (double)record.session.score_total / record.session.rounds : 0.0, record.session.best_score, (unsigned int)new_entries,
+            flappy_policy_get_name(policy_type));
+    printf("lifetime:   %u rounds, mean score %.2f, best score %u, %llu steps\n", record.lifetime.rounds,
+            (record.lifetime.rounds > 0) ? (double)record.lifetime.score_total / record.lifetime.rounds : 0.0, record.lifetime.best_score,
+            (unsigned long long)record.lifetime.steps);
+    for(unsigned int i = 0; i < record.entry_count; i++)
+        printf("%8u.  %5u  (session %u, %u steps)\n", i + 1, record.entries[i].score, record.entries[i].session, record.entries[i].steps);
+    printf("storage:    %lu changes in %lu writes, %lu failed\n", scores.change_count, scores.write_count, scores.failed_write_count);
+    return scores.failed_write_count > 0;
+}
\ No newline at end of file
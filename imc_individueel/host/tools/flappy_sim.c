@@ -0,0 +1,126 @@
+/*
+    Author: Kenley Strik
+    Addition: This whole file was written by Kenley Strik
+*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#include "flappy_bird_sim.h"
+#include "flappy_policy.h"
+#include "flappy_bird_replay.h"
+
+static const uint32_t FLAPPY_SIM_HASH_OFFSET = 2166136261u;    // Offset basis of the 32 bit FNV-1a hash
+static const uint32_t FLAPPY_SIM_HASH_PRIME = 16777619u;       // Prime of the 32 bit FNV-1a hash
+
+// Returns the time in nanoseconds of the monotonic clock
+static int64_t flappy_sim_get_time()
+{
+    struct timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return (int64_t)now.tv_sec * 1000000000 + now.tv_nsec;
+}
+
+// Writes the bytes of the replay to the replay file
+static bool flappy_sim_write_replay(void* context, const uint8_t* data, size_t length)
+{
+    return fwrite(data, 1, length, (FILE*)context) == length;
+}
+
+// Adds the 32 bit [value] to the FNV-1a [hash] one byte at a time and returns the new hash
+static uint32_t flappy_sim_hash(uint32_t hash, uint32_t value)
+{
+    for(int i = 0; i < 4; i++)
+    {
+        hash ^= (value >> (i * 8)) & 0xFF;
+        hash *= FLAPPY_SIM_HASH_PRIME;
+    }
+    return hash;
+}
+
+/*
+    Plays [steps] steps of the game with a policy (the autopilot by default) and prints the scores, the speed of
+    the simulation and a hash of the state after every step, which only changes when the rules change. The game is
+    recorded when a replay file is given, flappy_replay plays it back
+    Usage: flappy_sim [steps] [seed] [autopilot|noisy|random] [replay file]
+*/
+int main(int argc, char** argv)
+{
+    unsigned long steps = (argc > 1) ? strtoul(argv[1], NULL, 0) : 10000000;
+    unsigned int seed = (argc > 2) ? (unsigned int)strtoul(argv[2], NULL, 0) : 1;
+    flappy_policy_type_t policy_type = (argc > 3) ? flappy_policy_from_name(argv[3]) : FLAPPY_POLICY_AUTOPILOT;
+    if(policy_type == FLAPPY_POLICY_COUNT)
+    {
+        fprintf(stderr, "unknown policy %s\n", argv[3]);
+        return 1;
+    }
+
+    flappy_bird_sim_config_t config;
+    flappy_bird_sim_default_config(&config);
+    flappy_bird_sim_t sim;
+    if(!flappy_bird_sim_init(&sim, &config, seed))
+        return 1;
+    flappy_policy_t policy;
+    flappy_policy_init(&policy, policy_type, seed);
+
+    flappy_bird_recorder_t recorder = { 0 };
+    FILE* replay_stream = NULL;
+    if(argc > 4)
+    {
+        replay_stream = fopen(argv[4], "wb");
+        if(replay_stream == NULL || !flappy_bird_recorder_init(&recorder, &config, seed, &flappy_sim_write_replay, replay_stream))
+        {
+            fprintf(stderr, "%s: cannot create\n", argv[4]);
+            return 1;
+        }
+    }
+
+    uint32_t hash = FLAPPY_SIM_HASH_OFFSET;
+    unsigned long score_total = 0;
+    unsigned int best_score = 0;
+
+    int64_t start_time = flappy_sim_get_time();
+    for(unsigned long i = 0; i < steps; i++)
+    {
+        bool flap = flappy_policy_decide(&policy, &sim);
+        flappy_bird_recorder_step(&recorder, flap);
+        unsigned int events = flappy_bird_sim_step(&sim, flap);
+        if(events & FLAPPY_BIRD_SIM_EVENT_CRASH)
+        {
+            score_total += sim.last_score;
+            if(sim.last_score > best_score)
+                best_score = sim.last_score;
+        }
+
+        hash = flappy_sim_hash(hash, (uint32_t)sim.bird.yPosition);
+        hash = flappy_sim_hash(hash, (uint32_t)sim.pipelanes.xPositions[0] ^ ((uint32_t)sim.pipelanes.openingTops[0] << 16));
+        hash = flappy_sim_hash(hash, events);
+    }
+    int64_t elapsed = flappy_sim_get_time() - start_time;
+
+    // Draw the last step, so the drawing is part of what the run checks
+    matrix_bitmap_t bitmap;
+    if(!matrix_bitmap_init(&bitmap, 8, 16))
+        return 1;
+    flappy_bird_sim_draw(&sim, &bitmap);
+    for(unsigned int y = 0; y < bitmap.height; y++)
+        hash = flappy_sim_hash(hash, matrix_bitmap_get_bits(&bitmap, 0, y, bitmap.width));
+    matrix_bitmap_deinit(&bitmap);
+    flappy_bird_sim_deinit(&sim);
+
+    printf("steps:      %lu (seed %u, %s)\n", steps, seed, flappy_policy_get_name(policy_type));
+    printf("rounds:     %lu crashed, best score %u, mean score %.2f\n", sim.crash_count, best_score,
+            (sim.crash_count > 0) ? (double)score_total / sim.crash_count : 0.0);
+    printf("speed:      %.1f million steps per second\n", (elapsed > 0) ? steps * 1000.0 / elapsed : 0.0);
+    printf("state hash: %08x\n", hash);
+
+    if(replay_stream != NULL)
+    {
+        flappy_bird_recorder_deinit(&recorder);
+        printf("replay:     %lu flaps in %ld bytes%s\n", recorder.flap_count, ftell(replay_stream), recorder.has_failed ? ", writing failed" : "");
+        fclose(replay_stream);
+    }
+    return 0;
+}
\ No newline at end of file
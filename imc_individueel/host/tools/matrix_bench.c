@@ -0,0 +1,275 @@
+/*
+    Author: Kenley Strik
+    Addition: This whole file was written by Kenley Strik
+*/
+
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+
+#include "i2c_driver.h"
+#include "matrix_array.h"
+#include "matrix_dump.h"
+#include "i2c_host.h"
+#include "ht16k33_model.h"
+
+#define BENCH_MAX_PANELS 16                 // Maximum ammount of panels the bench can attach, 8 addresses on each of the two buses
+
+static const unsigned int BENCH_DEFAULT_PANELS = 16;            // Ammount of panels when it is not given on the command line
+static const unsigned int BENCH_DEFAULT_CLOCK_SPEED = 400000;   // I2C clock speed in Hz when it is not given on the command line
+static const int BENCH_SCROLL_STEPS = 8;                        // Ammount of frames of the scroll scenario
+static const unsigned int BENCH_CANVAS_WIDTH = 64;              // Size of the canvas of the canvas scenario, larger than the framebuffer of a few panels
+static const unsigned int BENCH_CANVAS_HEIGHT = 16;
+
+static ht16k33_model_t models[BENCH_MAX_PANELS];
+static unsigned int panel_count = 0;
+static bool has_failed = false;
+static matrix_dump_t dump;                  // Recording of what the panels show after every scenario, only used when a dump file is given
+static FILE* dump_stream = NULL;
+
+// Writes the bytes of the dump stream to the dump file
+static bool bench_write_dump(void* context, const uint8_t* data, size_t length)
+{
+    return fwrite(data, 1, length, (FILE*)context) == length;
+}
+
+// Resets the traffic counters of both buses and all the panels before a scenario
+static void bench_begin(void)
+{
+    for(int i = 0; i < I2C_NUM_MAX; i++)
+        i2c_host_reset_stats((i2c_port_t)i);
+    for(int i = 0; i < panel_count; i++)
+        ht16k33_model_reset_stats(&models[i]);
+}
+
+/*
+    Prints the traffic of scenario [name] and checks that every panel shows what the matrix array holds for it
+    and that the byte stream did not misuse the protocol
+*/
+static void bench_end(matrix_array_t** array, const char* name)
+{
+    i2c_host_stats_t total = { 0 };
+    int64_t slowest_bus_time = 0;          // Buses are updated in parallel, the slowest one decides how long the scenario takes
+    for(int i = 0; i < I2C_NUM_MAX; i++)
+    {
+        i2c_host_stats_t stats = i2c_host_get_stats((i2c_port_t)i);
+        total.transactions += stats.transactions;
+        total.bytes += stats.bytes;
+        total.nacks += stats.nacks;
+        total.bus_time += stats.bus_time;
+        if(stats.bus_time > slowest_bus_time)
+            slowest_bus_time = stats.bus_time;
+    }
+
+    unsigned long redundant_commands = 0;
+    unsigned long redundant_ram_writes = 0;
+    unsigned int mismatches = 0;
+    for(int i = 0; i < panel_count; i++)
+    {
+        redundant_commands += models[i].redundant_commands;
+        redundant_ram_writes += models[i].redundant_ram_writes;
+        if(models[i].misuse_count > 0)
+        {
+            printf("  panel 0x%02X on bus %d: %lu protocol misuses, last: %s\n", models[i].device.address, i % I2C_NUM_MAX, models[i].misuse_count, models[i].last_misuse);
+            has_failed = true;
+        }
+
+        // A lost panel is skipped by the update until the health task set it up again
+        matrix_display_t* display = &(*array)->matrix_displays[i];
+        if(display->is_lost || !models[i].is_connected)
+            continue;
+        for(uint8_t y = 0; y < 8; y++)
+        {
+            for(uint8_t x = 0; x < 8; x++)
+            {
+                if(ht16k33_model_get_pixel(&models[i], x, y) != matrix_display_get_pixel(display, x, y))
+                    mismatches++;
+            }
+        }
+        if(models[i].brightness != display->brightness || models[i].blink != display->blink
+            || models[i].is_display_on != display->is_display_on || models[i].is_oscillator_on == display->is_standby)
+            mismatches++;
+    }
+    if(mismatches > 0)
+    {
+        printf("  %u pixels or settings differ between the matrix array and the panels\n", mismatches);
+        has_failed = true;
+    }
+
+    printf("%-14s %8lu %8lu %6lu %10.2f %10.2f %10lu %10lu\n", name, total.transactions, total.bytes, total.nacks,
+        total.bus_time / 1000.0, slowest_bus_time / 1000.0, redundant_commands, redundant_ram_writes);
+
+    // Record what the panels hold, so the runs of the bench can be compared with matrix_dump diff
+    if(dump.is_initialized)
+    {
+        uint8_t rows[BENCH_MAX_PANELS * 8];
+        for(int i = 0; i < panel_count; i++)
+        {
+            for(uint8_t y = 0; y < 8; y++)
+                rows[i * 8 + y] = ht16k33_model_get_row(&models[i], y);
+        }
+        matrix_dump_capture_rows(&dump, rows);
+    }
+}
+
+/*
+    Measures the bus traffic of the matrix_display and matrix_array stack against virtual HT16K33 panels.
+    Usage: matrix_bench [panel count] [clock speed in Hz] [dump file]
+*/
+int main(int argc, char** argv)
+{
+    panel_count = (argc > 1) ? (unsigned int)atoi(argv[1]) : BENCH_DEFAULT_PANELS;
+    unsigned int clock_speed = (argc > 2) ? (unsigned int)atoi(argv[2]) : BENCH_DEFAULT_CLOCK_SPEED;
+    if(panel_count == 0 || panel_count > BENCH_MAX_PANELS || clock_speed == 0)
+    {
+        fprintf(stderr, "Usage: %s [panel count 1-%d] [clock speed in Hz] [dump file]\n", argv[0], BENCH_MAX_PANELS);
+        return 2;
+    }
+
+    // Panels alternate between the two buses, so both buses have to be set up
+    matrix_array_display_address_t addresses[BENCH_MAX_PANELS];
+    for(int i = 0; i < panel_count; i++)
+    {
+        addresses[i].i2c_port = (i2c_port_t)(i % I2C_NUM_MAX);
+        addresses[i].i2c_address = 0x70 + i / I2C_NUM_MAX;
+        ht16k33_model_init(&models[i], addresses[i].i2c_address);
+        ht16k33_model_attach(&models[i], addresses[i].i2c_port);
+    }
+    for(int i = 0; i < I2C_NUM_MAX; i++)
+        i2c_driver_init((i2c_port_t)i, I2C_MODE_MASTER, 23, 22, GPIO_PULLUP_ENABLE, GPIO_PULLUP_ENABLE, clock_speed);
+
+    printf("%u panels on %d buses at %u Hz\n", panel_count, I2C_NUM_MAX, clock_speed);
+    printf("%-14s %8s %8s %6s %10s %10s %10s %10s\n", "scenario", "trans", "bytes", "nacks", "bus ms", "wall ms", "red. cmd", "red. ram");
+
+    matrix_array_t* array = (matrix_array_t*)malloc(sizeof(matrix_array_t));
+    array->is_initialized = false;
+    matrix_array_init(&array, HORIZONTAL);
+    if(argc > 3)
+    {
+        // The header of the dump needs the layout of the panels, which the matrix array knows once they are added
+        dump_stream = fopen(argv[3], "wb");
+        if(dump_stream == NULL)
+        {
+            fprintf(stderr, "%s: cannot create\n", argv[3]);
+            return 2;
+        }
+    }
+
+    bench_begin();
+    if(!matrix_array_add_matrix_displays(&array, addresses, panel_count))
+    {
+        fprintf(stderr, "not enough memory for %u panels\n", panel_count);
+        return 1;
+    }
+    if(dump_stream != NULL)
+        matrix_dump_init(&dump, &array, &bench_write_dump, dump_stream);
+    bench_end(&array, "setup");
+
+    for(int i = 0; i < I2C_NUM_MAX; i++)
+        matrix_array_start_bus_worker(&array, (i2c_port_t)i, tskNO_AFFINITY);
+
+    int width = (int)array->framebuffer.width;
+    bench_begin();
+    matrix_array_set_pixel(&array, width / 2, 3, true);
+    matrix_array_update(&array);
+    bench_end(&array, "single pixel");
+
+    bench_begin();
+    matrix_array_update(&array);
+    bench_end(&array, "idle");
+
+    bench_begin();
+    matrix_array_fill_rect(&array, 0, 0, width, 8, true);
+    matrix_array_update(&array);
+    bench_end(&array, "fill");
+
+    bench_begin();
+    matrix_array_clear(&array);
+    for(int x = 0; x < width; x += 3)
+        matrix_array_draw_vline(&array, x, 0, 8, true);
+    matrix_array_update(&array);
+    for(int i = 0; i < BENCH_SCROLL_STEPS; i++)
+    {
+        matrix_array_shift_rows(&array, 0, 8, 1);
+        matrix_array_update(&array);
+    }
+    bench_end(&array, "scroll");
+
+    bench_begin();
+    matrix_array_set_brightness(&array, MATRIX_DISPLAY_DEFAULT_BRIGHTNESS);
+    matrix_array_set_brightness(&array, MATRIX_DISPLAY_MAX_BRIGHTNESS);
+    bench_end(&array, "brightness");
+
+    bench_begin();
+    matrix_array_fade_brightness(&array, 0, 160);
+    vTaskDelay(400 / portTICK_PERIOD_MS);
+    bench_end(&array, "fade");
+
+    // A panel that loses power is set up again by the health task and gets its rows back with the next update
+    bench_begin();
+    matrix_array_start_health_check(&array, 20, tskNO_AFFINITY);
+    ht16k33_model_set_connected(&models[0], false);
+    matrix_array_set_pixel(&array, 1, 1, true);
+    matrix_array_update(&array);
+    ht16k33_model_set_connected(&models[0], true);
+    vTaskDelay(100 / portTICK_PERIOD_MS);
+    matrix_array_update(&array);
+    matrix_array_stop_health_check(&array);
+    bench_end(&array, "recovery");
+
+    bench_begin();
+    matrix_array_clear(&array);
+    matrix_array_update(&array);
+    bench_end(&array, "clear");
+
+    // Pixels drawn on a canvas larger than the framebuffer are collected in the batch buffers as well, which have to fit the canvas
+    bench_begin();
+    matrix_display_value_pair_t canvas_pixels[] = { { 2, 3, true }, { BENCH_CANVAS_WIDTH - 4, BENCH_CANVAS_HEIGHT - 1, true } };
+    if(!matrix_array_attach_canvas(&array, BENCH_CANVAS_WIDTH, BENCH_CANVAS_HEIGHT, MATRIX_ARRAY_FRAMEBUFFER))
+    {
+        printf("  canvas could not be attached\n");
+        has_failed = true;
+    }
+    matrix_array_select_layer(&array, MATRIX_ARRAY_CANVAS);
+    matrix_array_set_pixels(&array, canvas_pixels, sizeof(canvas_pixels) / sizeof(canvas_pixels[0]));
+    if(!matrix_array_get_pixel(&array, BENCH_CANVAS_WIDTH - 4, BENCH_CANVAS_HEIGHT - 1))
+    {
+        printf("  pixel drawn on the canvas is not set\n");
+        has_failed = true;
+    }
+    matrix_array_select_layer(&array, MATRIX_ARRAY_FRAMEBUFFER);
+    matrix_array_update(&array);
+    bench_end(&array, "canvas");
+
+    if(dump_stream != NULL)
+    {
+        matrix_dump_deinit(&dump);
+        fclose(dump_stream);
+    }
+
+    matrix_array_stop_bus_workers(&array);
+    matrix_array_deinit(&array);
+    free(array);
+
+    // A canvas attached before any panel is added is drawn on before the framebuffer has a size
+    matrix_array_t* empty_array = (matrix_array_t*)malloc(sizeof(matrix_array_t));
+    empty_array->is_initialized = false;
+    matrix_array_init(&empty_array, HORIZONTAL);
+    matrix_array_attach_canvas(&empty_array, BENCH_CANVAS_WIDTH, BENCH_CANVAS_HEIGHT, MATRIX_ARRAY_FRAMEBUFFER);
+    matrix_array_select_layer(&empty_array, MATRIX_ARRAY_CANVAS);
+    matrix_array_set_pixels(&empty_array, canvas_pixels, sizeof(canvas_pixels) / sizeof(canvas_pixels[0]));
+    if(!matrix_array_get_pixel(&empty_array, BENCH_CANVAS_WIDTH - 4, BENCH_CANVAS_HEIGHT - 1))
+    {
+        printf("  pixel drawn on the canvas of an array without panels is not set\n");
+        has_failed = true;
+    }
+    matrix_array_deinit(&empty_array);
+    free(empty_array);
+    for(int i = 0; i < I2C_NUM_MAX; i++)
+        i2c_driver_deinit((i2c_port_t)i);
+
+    printf(has_failed ? "FAILED\n" : "OK\n");
+    return has_failed ? 1 : 0;
+}
\ No newline at end of file
@@ -0,0 +1,300 @@
+/*
+    Author: Kenley Strik
+    Addition: This whole file was written by Kenley Strik
+*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "matrix_dump.h"
+
+// Type for representing a dump stream that was read into memory
+typedef struct
+{
+    uint8_t* data;                          // Bytes of the dump file
+    size_t size;                            // Size in bytes of the dump file
+    display_orientation_t orientation;      // Orientation of the matrix array that was recorded
+    unsigned int panel_count;               // Ammount of panels in every frame
+    unsigned int width;                     // Width in pixels of the matrix array
+    unsigned int height;                    // Height in pixels of the matrix array
+    const uint8_t** frames;                 // Frame record of every frame, repeated frames point to the same record
+    unsigned long frame_count;              // Ammount of frames in the dump
+    unsigned long record_count;             // Ammount of frame records, the other frames are repeats
+} dump_file_t;
+
+// Returns the little endian 16 bit value at [data]
+static unsigned int dump_read16(const uint8_t* data)
+{
+    return data[0] | (data[1] << 8);
+}
+
+// Returns the little endian 32 bit value at [data]
+static uint32_t dump_read32(const uint8_t* data)
+{
+    return (uint32_t)data[0] | ((uint32_t)data[1] << 8) | ((uint32_t)data[2] << 16) | ((uint32_t)data[3] << 24);
+}
+
+// Returns the rows of frame [index], 8 bytes per panel
+static const uint8_t* dump_get_rows(const dump_file_t* file, unsigned long index)
+{
+    return file->frames[index] + 1;
+}
+
+// Returns the hash the record of frame [index] stores
+static uint32_t dump_get_hash(const dump_file_t* file, unsigned long index)
+{
+    return dump_read32(file->frames[index] + 1 + file->panel_count * 8);
+}
+
+// Returns the hash of the rows of frame [index], which differs from the stored hash when the rows were damaged
+static uint32_t dump_compute_hash(const dump_file_t* file, unsigned long index)
+{
+    return matrix_dump_hash(dump_get_rows(file, index), file->panel_count * 8);
+}
+
+// Returns true if the pixel at [x, y] of frame [index] is on, the panels are placed like the matrix array places them
+static bool dump_get_pixel(const dump_file_t* file, unsigned long index, unsigned int x, unsigned int y)
+{
+    const uint8_t* rows = dump_get_rows(file, index);
+    if(file->orientation == HORIZONTAL)
+        return (rows[(x / 8) * 8 + y] >> (x % 8)) & 0x01;
+    return (rows[(y / 8) * 8 + y % 8] >> x) & 0x01;
+}
+
+// Reads the dump at [path] and indexes its frames, returns false and prints why if it is not a valid dump
+static bool dump_load(dump_file_t* file, const char* path)
+{
+    memset(file, 0, sizeof(dump_file_t));
+    FILE* stream = fopen(path, "rb");
+    if(stream == NULL)
+    {
+        fprintf(stderr, "%s: cannot open\n", path);
+        return false;
+    }
+    fseek(stream, 0, SEEK_END);
+    file->size = (size_t)ftell(stream);
+    fseek(stream, 0, SEEK_SET);
+    file->data = (uint8_t*)malloc(file->size + 1);
+    bool is_read = file->data != NULL && fread(file->data, 1, file->size, stream) == file->size;
+    fclose(stream);
+    if(!is_read || file->size < MATRIX_DUMP_HEADER_SIZE || memcmp(file->data, MATRIX_DUMP_MAGIC, 4) != 0 || file->data[4] != MATRIX_DUMP_VERSION)
+    {
+        fprintf(stderr, "%s: not a version %d matrix dump\n", path, MATRIX_DUMP_VERSION);
+        return false;
+    }
+
+    file->orientation = (display_orientation_t)file->data[5];
+    file->panel_count = dump_read16(&file->data[6]);
+    file->width = dump_read16(&file->data[8]);
+    file->height = dump_read16(&file->data[10]);
+    size_t record_size = 1 + file->panel_count * 8 + 4;
+
+    // Index every frame, a repeat record adds the last frame record again
+    unsigned long capacity = 64;
+    file->frames = (const uint8_t**)malloc(sizeof(const uint8_t*) * capacity);
+    size_t offset = MATRIX_DUMP_HEADER_SIZE;
+    while(offset < file->size)
+    {
+        unsigned long count = 0;
+        const uint8_t* record = NULL;
+        if(file->data[offset] == MATRIX_DUMP_RECORD_FRAME && offset + record_size <= file->size)
+        {
+            record = &file->data[offset];
+            count = 1;
+            offset += record_size;
+            file->record_count++;
+        }
+        else if(file->data[offset] == MATRIX_DUMP_RECORD_REPEAT && offset + 3 <= file->size && file->frame_count > 0)
+        {
+            record = file->frames[file->frame_count - 1];
+            count = dump_read16(&file->data[offset + 1]);
+            offset += 3;
+        }
+        else
+        {
+            fprintf(stderr, "%s: broken record at offset %zu\n", path, offset);
+            return false;
+        }
+
+        for(unsigned long i = 0; i < count; i++)
+        {
+            if(file->frame_count == capacity)
+            {
+                capacity *= 2;
+                file->frames = (const uint8_t**)realloc(file->frames, sizeof(const uint8_t*) * capacity);
+            }
+            file->frames[file->frame_count++] = record;
+        }
+    }
+    return true;
+}
+
+// Releases the memory of a dump that was read into memory
+static void dump_free(dump_file_t* file)
+{
+    free(file->frames);
+    free(file->data);
+}
+
+// Prints frame [index] as ASCII art, '#' for a pixel that is on
+static void dump_print_ascii(const dump_file_t* file, unsigned long index)
+{
+    printf("frame %lu hash %08x\n", index, dump_get_hash(file, index));
+    for(unsigned int y = 0; y < file->height; y++)
+    {
+        for(unsigned int x = 0; x < file->width; x++)
+            putchar(dump_get_pixel(file, index, x, y) ? '#' : '.');
+        putchar('\n');
+    }
+}
+
+// Writes frame [index] as a binary PPM image to [path], every pixel becomes a square of [scale] x [scale] image pixels
+static bool dump_write_ppm(const dump_file_t* file, unsigned long index, const char* path, unsigned int scale)
+{
+    FILE* stream = fopen(path, "wb");
+    if(stream == NULL)
+    {
+        fprintf(stderr, "%s: cannot create\n", path);
+        return false;
+    }
+
+    static const uint8_t on_color[3] = { 0xFF, 0x30, 0x20 };     // Color of a lit LED of the red matrix modules
+    static const uint8_t off_color[3] = { 0x20, 0x08, 0x08 };    // Color of an unlit LED
+    fprintf(stream, "P6\n%u %u\n255\n", file->width * scale, file->height * scale);
+    for(unsigned int y = 0; y < file->height * scale; y++)
+    {
+        for(unsigned int x = 0; x < file->width * scale; x++)
+            fwrite(dump_get_pixel(file, index, x / scale, y / scale) ? on_color : off_color, 1, 3, stream);
+    }
+    return fclose(stream) == 0;
+}
+
+// Prints the layout of the dump and checks that the stored hash of every frame record matches its rows
+static int dump_info(const dump_file_t* file)
+{
+    printf("%u panels, %ux%u pixels, %s\n", file->panel_count, file->width, file->height, file->orientation == HORIZONTAL ? "horizontal" : "vertical");
+    printf("%lu frames, %lu frame records, %zu bytes\n", file->frame_count, file->record_count, file->size);
+
+    unsigned long broken = 0;
+    for(unsigned long i = 0; i < file->frame_count; i++)
+    {
+        if(dump_compute_hash(file, i) != dump_get_hash(file, i))
+            broken++;
+    }
+    if(broken > 0)
+        printf("%lu frames do not match their hash\n", broken);
+    return broken > 0 ? 1 : 0;
+}
+
+/*
+    Compares the frames of [file] with the golden recording [golden] by the hashes of their rows, prints the first frame
+    that differs next to the golden frame and returns 1, or returns 0 if the recordings show the same frames
+*/
+static int dump_diff(const dump_file_t* file, const dump_file_t* golden)
+{
+    if(file->panel_count != golden->panel_count || file->width != golden->width || file->height != golden->height || file->orientation != golden->orientation)
+    {
+        printf("layout differs: %u panels %ux%u, golden %u panels %ux%u\n", file->panel_count, file->width, file->height, golden->panel_count, golden->width, golden->height);
+        return 1;
+    }
+
+    unsigned long frame_count = (file->frame_count < golden->frame_count) ? file->frame_count : golden->frame_count;
+    for(unsigned long i = 0; i < frame_count; i++)
+    {
+        uint32_t hash = dump_compute_hash(file, i);
+        uint32_t golden_hash = dump_compute_hash(golden, i);
+        if(hash == golden_hash)
+            continue;
+
+        // Show the frame next to the golden frame, pixels that differ are marked
+        printf("frame %lu differs: hash %08x, golden %08x\n", i, hash, golden_hash);
+        for(unsigned int y = 0; y < file->height; y++)
+        {
+            for(unsigned int x = 0; x < file->width; x++)
+                putchar(dump_get_pixel(file, i, x, y) ? '#' : '.');
+            printf("   ");
+            for(unsigned int x = 0; x < file->width; x++)
+                putchar(dump_get_pixel(golden, i, x, y) ? '#' : '.');
+            printf("   ");
+            for(unsigned int x = 0; x < file->width; x++)
+                putchar(dump_get_pixel(file, i, x, y) != dump_get_pixel(golden, i, x, y) ? 'X' : ' ');
+            putchar('\n');
+        }
+        return 1;
+    }
+
+    if(file->frame_count != golden->frame_count)
+    {
+        printf("frame count differs: %lu, golden %lu\n", file->frame_count, golden->frame_count);
+        return 1;
+    }
+    printf("%lu frames match\n", frame_count);
+    return 0;
+}
+
+/*
+    Converts and compares matrix dumps.
+    Usage: matrix_dump info FILE
+           matrix_dump hashes FILE
+           matrix_dump ascii FILE [FIRST [LAST]]
+           matrix_dump ppm FILE FRAME OUTPUT [SCALE]
+           matrix_dump diff FILE GOLDEN
+*/
+int main(int argc, char** argv)
+{
+    if(argc < 3)
+    {
+        fprintf(stderr, "Usage: %s info|hashes|ascii|ppm|diff FILE [...]\n", argv[0]);
+        return 2;
+    }
+
+    dump_file_t file;
+    if(!dump_load(&file, argv[2]))
+        return 2;
+
+    int result = 0;
+    if(strcmp(argv[1], "info") == 0)
+        result = dump_info(&file);
+    else if(strcmp(argv[1], "hashes") == 0)
+    {
+        for(unsigned long i = 0; i < file.frame_count; i++)
+            printf("%lu %08x\n", i, dump_get_hash(&file, i));
+    }
+    else if(strcmp(argv[1], "ascii") == 0)
+    {
+        unsigned long first = (argc > 3) ? strtoul(argv[3], NULL, 0) : 0;
+        unsigned long last = (argc > 4) ? strtoul(argv[4], NULL, 0) : (argc > 3 ? first : file.frame_count - 1);
+        for(unsigned long i = first; i <= last && i < file.frame_count; i++)
+            dump_print_ascii(&file, i);
+    }
+    else if(strcmp(argv[1], "ppm") == 0 && argc > 4)
+    {
+        unsigned long index = strtoul(argv[3], NULL, 0);
+        unsigned int scale = (argc > 5) ? (unsigned int)atoi(argv[5]) : 8;
+        if(index >= file.frame_count || scale == 0)
+        {
+            fprintf(stderr, "frame %lu does not exist, the dump has %lu frames\n", index, file.frame_count);
+            result = 2;
+        }
+        else if(!dump_write_ppm(&file, index, argv[4], scale))
+            result = 2;
+    }
+    else if(strcmp(argv[1], "diff") == 0 && argc > 3)
+    {
+        dump_file_t golden;
+        if(dump_load(&golden, argv[3]))
+            result = dump_diff(&file, &golden);
+        else
+            result = 2;
+        dump_free(&golden);
+    }
+    else
+    {
+        fprintf(stderr, "Usage: %s info|hashes|ascii|ppm|diff FILE [...]\n", argv[0]);
+        result = 2;
+    }
+
+    dump_free(&file);
+    return result;
+}
\ No newline at end of file
@@ -15,15 +15,15 @@ void init_nvs_flash();
 void app_main(void)
 {
     init_nvs_flash();                                                                               // Initialize nvs_flash
-    i2c_driver_init(I2C_MODE_MASTER, 23, 22, GPIO_PULLUP_ENABLE, GPIO_PULLUP_ENABLE, 9600);         // Initialize i2c_driver
+    i2c_driver_init(I2C_NUM_0, I2C_MODE_MASTER, 23, 22, GPIO_PULLUP_ENABLE, GPIO_PULLUP_ENABLE, 9600);  // Initialize i2c_driver on the first bus
 
     flappy_bird_init();                         // Initialize the flappy bird game
-    flappy_bird_start();                        // Start the flappy bird game
+    flappy_bird_start(5, 1);                    // Start the flappy bird game with its own task on the second core
 
     // This code should be run to stop and release the resources of the flappy bird game
     // flappy_bird_stop();                         // Stop the flappy bird game
     // flappy_bird_deinit();                       // Uninitialize the flappy bird game
-    // i2c_driver_deinit();                        // Uninitialize i2c_driver
+    // i2c_driver_deinit(I2C_NUM_0);               // Uninitialize i2c_driver
 }
 
 // Initializes nvs_flash